@@ -0,0 +1,100 @@
+#include "Bench.h"
+#include "../src/Change.h"
+#include "../src/Sum.h"
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+/* Counter of the thread currently inside countAllocations, or null. Being
+ * thread-local and unset everywhere else, the replaced operator new costs the
+ * other suites (including the threaded ones) one TLS load and no shared writes. */
+thread_local long long *allocationCounter = nullptr;
+
+/* Number of heap allocations made by f on the calling thread */
+template <class F>
+long long countAllocations(F f)
+{
+    long long count = 0;
+    allocationCounter = &count;
+    f();
+    allocationCounter = nullptr;
+    return count;
+}
+
+/* Formatting as calcChange/calcSum did it before the structured results */
+string legacyChange(CoinSystem &coins, int m)
+{
+    string change;
+    vector<int> counts(3);
+    coins.calcChangeCounts(m, counts.data());
+    int values[] = {1, 2, 5};
+    for (int i = 2; i >= 0; i--)
+        for (int n = 0; n < counts[i]; n++)
+            change += to_string(values[i]) + ";";
+    return change;
+}
+
+string legacySums(const vector<pair<long long, int> > &sums)
+{
+    string result;
+    for (size_t i = 0; i < sums.size(); i++)
+        result += to_string(sums[i].first) + "," + to_string(sums[i].second) + ";";
+    return result;
+}
+}
+
+// GCC cannot see that the replaced operator new also uses malloc.
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+
+void *operator new(size_t size)
+{
+    if (allocationCounter != nullptr)
+        ++*allocationCounter;
+    if (void *p = malloc(size ? size : 1))
+        return p;
+    throw bad_alloc();
+}
+
+void operator delete(void *p) noexcept
+{
+    free(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+    free(p);
+}
+
+void benchAllocations(BenchRunner &runner)
+{
+    int coinValues[] = {1, 2, 5};
+    CoinSystem coins(3, coinValues);
+    int counts[3];
+    const int m = 1000000;
+    string params = "m=" + to_string(m);
+    runner.record("allocations", "legacy change string", params,
+            "allocations=" + to_string(countAllocations([&]() { legacyChange(coins, m); })));
+    runner.record("allocations", "calcChange", params,
+            "allocations=" + to_string(countAllocations([&]() { coins.calcChange(m); })));
+    runner.record("allocations", "calcChangeCounts", params,
+            "allocations=" + to_string(countAllocations([&]() { coins.calcChangeCounts(m, counts); })));
+    runner.run("allocations", "legacy change string", params, [&]() { legacyChange(coins, m); });
+    runner.run("allocations", "formatChange", params, [&]() { formatChange(3, coinValues, counts); });
+
+    const int size = 20000;
+    vector<int> sequence(size);
+    for (int i = 0; i < size; i++)
+        sequence[i] = (i * 7919) % 2001 - 1000;
+    vector<pair<long long, int> > sums = calcMinSums(sequence.data(), size);
+    vector<pair<long long, int> > buffer(size);
+    params = "n=" + to_string(size);
+    runner.record("allocations", "legacy sum string", params,
+            "allocations=" + to_string(countAllocations([&]() { legacySums(sums); })));
+    runner.record("allocations", "formatSums", params,
+            "allocations=" + to_string(countAllocations([&]() { formatSums(sums.data(), size); })));
+    runner.record("allocations", "calcMinSums buffer", params,
+            "allocations=" + to_string(countAllocations([&]() { calcMinSums(sequence.data(), size, buffer.data()); })));
+    runner.run("allocations", "legacy sum string", params, [&]() { legacySums(sums); });
+    runner.run("allocations", "formatSums", params, [&]() { formatSums(sums.data(), size); });
+}
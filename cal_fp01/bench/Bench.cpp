@@ -0,0 +1,104 @@
+#include "Bench.h"
+#include <cstring>
+#include <iomanip>
+
+namespace
+{
+string jsonString(const string &s)
+{
+    string escaped = "\"";
+    for (char c : s)
+    {
+        if (c == '"' || c == '\\')
+            escaped += '\\';
+        escaped += c;
+    }
+    return escaped + "\"";
+}
+
+void usage(const char *program)
+{
+    cerr << "usage: " << program << " [--csv | --json] [--filter SUITE] [--reps N] [--warmup N]" << endl
+         << "suites: factorial, change, change-kernel, sum, partitioning, stirling-row, allocations" << endl;
+}
+}
+
+void printTable(ostream &out, const vector<BenchResult> &results)
+{
+    out << left << setw(14) << "suite" << setw(22) << "case" << setw(22) << "params"
+        << right << setw(6) << "reps" << setw(14) << "median ms" << setw(14) << "p95 ms" << "  note" << endl;
+    for (const BenchResult &r : results)
+        out << left << setw(14) << r.suite << setw(22) << r.name << setw(22) << r.params
+            << right << setw(6) << r.reps << setw(14) << r.medianMs << setw(14) << r.p95Ms
+            << "  " << r.note << endl;
+}
+
+void printCsv(ostream &out, const vector<BenchResult> &results)
+{
+    out << "suite,case,params,reps,median_ms,p95_ms,note" << endl;
+    for (const BenchResult &r : results)
+        out << r.suite << "," << r.name << "," << r.params << "," << r.reps << ","
+            << r.medianMs << "," << r.p95Ms << "," << r.note << endl;
+}
+
+void printJson(ostream &out, const vector<BenchResult> &results)
+{
+    out << "[" << endl;
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const BenchResult &r = results[i];
+        out << "  {\"suite\": " << jsonString(r.suite) << ", \"case\": " << jsonString(r.name)
+            << ", \"params\": " << jsonString(r.params) << ", \"reps\": " << r.reps
+            << ", \"median_ms\": " << r.medianMs << ", \"p95_ms\": " << r.p95Ms
+            << ", \"note\": " << jsonString(r.note) << "}" << (i + 1 < results.size() ? "," : "") << endl;
+    }
+    out << "]" << endl;
+}
+
+int main(int argc, char const *argv[])
+{
+    string format = "table", filter;
+    int reps = 5, warmup = 1;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--csv") == 0)
+            format = "csv";
+        else if (strcmp(argv[i], "--json") == 0)
+            format = "json";
+        else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc)
+            filter = argv[++i];
+        else if (strcmp(argv[i], "--reps") == 0 && i + 1 < argc)
+            reps = max(1, atoi(argv[++i]));
+        else if (strcmp(argv[i], "--warmup") == 0 && i + 1 < argc)
+            warmup = max(0, atoi(argv[++i]));
+        else
+        {
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    BenchRunner runner(warmup, reps, filter);
+    if (runner.enabled("factorial"))
+        benchFactorial(runner);
+    if (runner.enabled("change"))
+        benchChange(runner);
+    if (runner.enabled("change-kernel"))
+        benchChangeKernel(runner);
+    if (runner.enabled("sum"))
+        benchSum(runner);
+    if (runner.enabled("partitioning"))
+        benchPartitioning(runner);
+    if (runner.enabled("stirling-row"))
+        benchStirlingRow(runner);
+    if (runner.enabled("allocations"))
+        benchAllocations(runner);
+
+    if (format == "csv")
+        printCsv(cout, runner.getResults());
+    else if (format == "json")
+        printJson(cout, runner.getResults());
+    else
+        printTable(cout, runner.getResults());
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,95 @@
+/*
+ * Bench.h
+ */
+
+#ifndef BENCH_H_
+#define BENCH_H_
+
+#include "../src/Defs.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+/* Resultado de um caso: mediana e percentil 95 do tempo de parede (ms) */
+struct BenchResult
+{
+    string suite;
+    string name;
+    string params;
+    int reps;
+    double medianMs;
+    double p95Ms;
+    string note;
+};
+
+/* Executa os casos de benchmark: warmup execucoes descartadas seguidas de reps
+ * execucoes medidas. Com filter nao vazio so corre a suite com esse nome exato
+ * (por exemplo, "change" nao inclui "change-kernel").
+ * */
+class BenchRunner
+{
+    int warmup;
+    int reps;
+    string filter;
+    vector<BenchResult> results;
+
+public:
+    BenchRunner(int warmup, int reps, const string &filter)
+        : warmup(warmup), reps(reps), filter(filter) {}
+
+    bool enabled(const string &suite) const
+    {
+        return filter.empty() || suite == filter;
+    }
+
+    /* Mede f; maxReps limita as repeticoes dos casos mais lentos (0 = sem limite) */
+    template <class F>
+    BenchResult &run(const string &suite, const string &name, const string &params, F f, int maxReps = 0)
+    {
+        int count = maxReps > 0 ? min(reps, maxReps) : reps;
+        for (int i = 0; i < (maxReps > 0 ? min(warmup, maxReps) : warmup); i++)
+            f();
+
+        vector<double> samples;
+        for (int i = 0; i < count; i++)
+        {
+            auto start = chrono::steady_clock::now();
+            f();
+            chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - start;
+            samples.push_back(elapsed.count());
+        }
+        sort(samples.begin(), samples.end());
+        size_t p95 = (size_t) (0.95 * samples.size() + 0.999999) - 1;
+        BenchResult result = { suite, name, params, count, samples[samples.size() / 2], samples[p95], "" };
+        results.push_back(result);
+        cerr << suite << " " << name << " " << params << ": " << result.medianMs << " ms" << endl;
+        return results.back();
+    }
+
+    /* Regista um resultado sem tempo (por exemplo, contagens de alocacoes) */
+    void record(const string &suite, const string &name, const string &params, const string &note)
+    {
+        BenchResult result = { suite, name, params, 0, 0, 0, note };
+        results.push_back(result);
+    }
+
+    const vector<BenchResult> &getResults() const
+    {
+        return results;
+    }
+};
+
+void printTable(ostream &out, const vector<BenchResult> &results);
+void printCsv(ostream &out, const vector<BenchResult> &results);
+void printJson(ostream &out, const vector<BenchResult> &results);
+
+void benchFactorial(BenchRunner &runner);
+void benchChange(BenchRunner &runner);
+void benchChangeKernel(BenchRunner &runner);
+void benchSum(BenchRunner &runner);
+void benchPartitioning(BenchRunner &runner);
+void benchStirlingRow(BenchRunner &runner);
+void benchAllocations(BenchRunner &runner);
+
+#endif /* BENCH_H_ */
@@ -0,0 +1,51 @@
+#include "Bench.h"
+#include "../src/Change.h"
+#include "../src/ChangeKernel.h"
+#include <vector>
+
+void benchChange(BenchRunner &runner)
+{
+    // Non-canonical systems of growing size, so the DP path is measured.
+    vector<int> coinValues = {1, 3, 4, 11, 17, 29, 41, 59, 71, 97};
+    for (int numCoins : {3, 6, 10})
+    {
+        for (int m : {1000, 100000, 1000000})
+        {
+            string params = "coins=" + to_string(numCoins) + " m=" + to_string(m);
+            runner.run("change", "calcChange", params, [&]() {
+                calcChange(m, numCoins, coinValues.data());
+            });
+            CoinSystem coins(numCoins, coinValues.data(), m);
+            runner.run("change", "CoinSystem 1000 queries", params, [&]() {
+                for (int q = 0; q < 1000; q++)
+                    coins.calcChange(m - q * (m / 1000));
+            });
+        }
+    }
+
+    int euro[] = {1, 2, 5, 10, 20, 50, 100, 200};
+    runner.run("change", "calcChange greedy", "coins=8 m=1000000", [&]() {
+        calcChange(1000000, 8, euro);
+    });
+}
+
+void benchChangeKernel(BenchRunner &runner)
+{
+    int coinValues[] = {1, 3, 7, 12, 25, 40, 97};
+    int numCoins = 7;
+    for (int m : {10000, 100000, 1000000, 10000000, 100000000})
+    {
+        vector<int> minCoins(m + 1), lastCoin(m + 1);
+        auto run = [&](void (*relax)(int *, int *, int, int, int)) {
+            fill(minCoins.begin(), minCoins.end(), 1 << 20);
+            fill(lastCoin.begin(), lastCoin.end(), 0);
+            minCoins[0] = 0;
+            for (int i = 0; i < numCoins; i++)
+                relax(minCoins.data(), lastCoin.data(), m, coinValues[i], i);
+        };
+        string params = "m=" + to_string(m);
+        int maxReps = m >= 10000000 ? 1 : 0;
+        runner.run("change-kernel", "scalar", params, [&]() { run(relaxCoinScalar); }, maxReps);
+        runner.run("change-kernel", "vectorized", params, [&]() { run(relaxCoin); }, maxReps);
+    }
+}
@@ -0,0 +1,46 @@
+#include "Bench.h"
+#include "../src/Factorial.h"
+#include <thread>
+
+void benchFactorial(BenchRunner &runner)
+{
+    const int calls = 100000;
+    volatile int sink = 0;
+    for (int n : {5, 10, 12})
+    {
+        string params = "n=" + to_string(n) + " x" + to_string(calls);
+        runner.run("factorial", "factorialRecurs", params, [&]() {
+            for (int i = 0; i < calls; i++)
+                sink = factorialRecurs(n);
+        });
+        runner.run("factorial", "factorialDinam", params, [&]() {
+            for (int i = 0; i < calls; i++)
+                sink = factorialDinam(n);
+        });
+        runner.run("factorial", "factorialMemoized", params, [&]() {
+            for (int i = 0; i < calls; i++)
+                sink = factorialMemoized(n);
+        });
+    }
+
+    unsigned threads = max(2u, thread::hardware_concurrency());
+    for (int n : {1000, 10000, 100000, 1000000})
+    {
+        string params = "n=" + to_string(n);
+        // The naive loop is quadratic; past 10^5 it only measures patience.
+        if (n <= 100000)
+            runner.run("factorial", "naive BigInt loop", params, [n]() {
+                BigInt fact(1);
+                for (int i = 2; i <= n; i++)
+                    fact *= i;
+            }, n >= 100000 ? 1 : 0);
+        runner.run("factorial", "factorialBig", params, [n]() {
+            clearFactorialCache();
+            factorialBig(n);
+        }, n >= 1000000 ? 1 : 0);
+        runner.run("factorial", "factorialBig x" + to_string(threads), params, [n, threads]() {
+            clearFactorialCache();
+            factorialBig(n, threads);
+        }, n >= 1000000 ? 1 : 0);
+    }
+}
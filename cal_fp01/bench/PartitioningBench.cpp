@@ -0,0 +1,57 @@
+#include "Bench.h"
+#include "../src/ConstTables.h"
+#include "../src/Partitioning.h"
+
+namespace
+{
+/* Row s(n, 0..n) mod p with the s_dynamic recurrence, one row at a time */
+vector<uint32_t> stirlingRowDynamic(int n, uint32_t p)
+{
+    vector<uint32_t> row(n + 1, 0);
+    row[0] = 1;
+    for (int i = 1; i <= n; i++)
+    {
+        for (int k = i; k >= 1; k--)
+            row[k] = addMod(mulMod(row[k], k, p), row[k - 1], p);
+        row[0] = 0;
+    }
+    return row;
+}
+}
+
+void benchPartitioning(BenchRunner &runner)
+{
+    volatile int sink = 0;
+    for (int n : {5, 10, 15})
+    {
+        string params = "n=" + to_string(n);
+        runner.run("partitioning", "b_recursive", params, [&]() { sink = b_recursive(n); });
+        runner.run("partitioning", "b_dynamic", params, [&]() { sink = b_dynamic(n); });
+        runner.run("partitioning", "b_memoized", params, [&]() { sink = b_memoized(n); });
+        runner.run("partitioning", "bellLookup", params, [&]() { sink = (int) bellLookup(n); });
+    }
+    for (int n : {100, 1000})
+    {
+        runner.run("partitioning", "StirlingTable b(n)", "n=" + to_string(n), [n]() {
+            StirlingTable<BigIntRing> table;
+            table.b(n);
+        });
+    }
+}
+
+void benchStirlingRow(BenchRunner &runner)
+{
+    for (int n : {1000, 10000, 100000})
+    {
+        vector<uint32_t> dynamic, transform;
+        string params = "n=" + to_string(n);
+        runner.run("stirling-row", "DP recurrence", params, [&]() {
+            dynamic = stirlingRowDynamic(n, NTT_PRIME);
+        }, n >= 100000 ? 1 : 0);
+        BenchResult &result = runner.run("stirling-row", "NTT", params, [&]() {
+            transform = stirlingRowMod(n);
+        });
+        if (dynamic != transform)
+            result.note = "MISMATCH";
+    }
+}
@@ -0,0 +1,27 @@
+#include "Bench.h"
+#include "../src/Sum.h"
+#include <thread>
+
+void benchSum(BenchRunner &runner)
+{
+    unsigned threads = max(2u, thread::hardware_concurrency());
+    for (int size : {100, 1000, 10000})
+    {
+        vector<int> sequence(size);
+        for (int i = 0; i < size; i++)
+            sequence[i] = (i * 7919) % 2001 - 1000;
+        string params = "n=" + to_string(size);
+
+        runner.run("sum", "calcSum", params, [&]() {
+            calcSum(sequence.data(), size);
+        });
+        runner.run("sum", "calcMinSums x" + to_string(threads), params, [&]() {
+            calcMinSums(sequence.data(), size, threads);
+        });
+        runner.run("sum", "StreamingMinSum 3 windows", params, [&]() {
+            StreamingMinSum stream({1, size / 10 + 1, size / 2});
+            for (int value : sequence)
+                stream.push(value);
+        });
+    }
+}
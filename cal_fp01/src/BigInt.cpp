@@ -0,0 +1,263 @@
+/*
+ * BigInt.cpp
+ */
+
+#include "BigInt.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace
+{
+const size_t KARATSUBA_THRESHOLD = 40;
+
+typedef vector<uint32_t> Limbs;
+
+void trimLimbs(Limbs &x)
+{
+    while (!x.empty() && x.back() == 0)
+        x.pop_back();
+}
+
+Limbs schoolbook(const uint32_t *a, size_t na, const uint32_t *b, size_t nb)
+{
+    Limbs result(na + nb, 0);
+    for (size_t i = 0; i < na; i++)
+    {
+        uint64_t carry = 0;
+        for (size_t j = 0; j < nb; j++)
+        {
+            uint64_t cur = (uint64_t) a[i] * b[j] + result[i + j] + carry;
+            result[i + j] = (uint32_t) cur;
+            carry = cur >> 32;
+        }
+        result[i + nb] = (uint32_t) carry;
+    }
+    return result;
+}
+
+Limbs addLimbs(const uint32_t *a, size_t na, const uint32_t *b, size_t nb)
+{
+    if (na < nb)
+    {
+        swap(a, b);
+        swap(na, nb);
+    }
+    Limbs result(na + 1);
+    uint64_t carry = 0;
+    for (size_t i = 0; i < na; i++)
+    {
+        carry += a[i];
+        if (i < nb)
+            carry += b[i];
+        result[i] = (uint32_t) carry;
+        carry >>= 32;
+    }
+    result[na] = (uint32_t) carry;
+    trimLimbs(result);
+    return result;
+}
+
+/* r += x << (32 * offset); r must be large enough to hold the sum */
+void addShifted(Limbs &r, const Limbs &x, size_t offset)
+{
+    uint64_t carry = 0;
+    size_t i = 0;
+    for (; i < x.size(); i++)
+    {
+        carry += (uint64_t) r[offset + i] + x[i];
+        r[offset + i] = (uint32_t) carry;
+        carry >>= 32;
+    }
+    for (i += offset; carry != 0; i++)
+    {
+        carry += r[i];
+        r[i] = (uint32_t) carry;
+        carry >>= 32;
+    }
+}
+
+/* r -= x, with r >= x */
+void subtractInPlace(Limbs &r, const Limbs &x)
+{
+    int64_t borrow = 0;
+    size_t i = 0;
+    for (; i < x.size(); i++)
+    {
+        int64_t cur = (int64_t) r[i] - x[i] - borrow;
+        borrow = cur < 0;
+        r[i] = (uint32_t) (cur + (borrow << 32));
+    }
+    for (; borrow != 0; i++)
+    {
+        int64_t cur = (int64_t) r[i] - borrow;
+        borrow = cur < 0;
+        r[i] = (uint32_t) (cur + (borrow << 32));
+    }
+    trimLimbs(r);
+}
+
+Limbs multiply(const uint32_t *a, size_t na, const uint32_t *b, size_t nb)
+{
+    if (na < nb)
+    {
+        swap(a, b);
+        swap(na, nb);
+    }
+    if (nb == 0)
+        return Limbs();
+    if (nb < KARATSUBA_THRESHOLD)
+    {
+        Limbs result = schoolbook(a, na, b, nb);
+        trimLimbs(result);
+        return result;
+    }
+
+    size_t half = na / 2;
+    Limbs result(na + nb, 0);
+    if (nb <= half)
+    {
+        // Unbalanced operands: split only the longer one.
+        addShifted(result, multiply(a, half, b, nb), 0);
+        addShifted(result, multiply(a + half, na - half, b, nb), half);
+        trimLimbs(result);
+        return result;
+    }
+
+    Limbs z0 = multiply(a, half, b, half);
+    Limbs z2 = multiply(a + half, na - half, b + half, nb - half);
+    Limbs sumA = addLimbs(a, half, a + half, na - half);
+    Limbs sumB = addLimbs(b, half, b + half, nb - half);
+    Limbs z1 = multiply(sumA.data(), sumA.size(), sumB.data(), sumB.size());
+    subtractInPlace(z1, z0);
+    subtractInPlace(z1, z2);
+
+    addShifted(result, z0, 0);
+    addShifted(result, z1, half);
+    addShifted(result, z2, 2 * half);
+    trimLimbs(result);
+    return result;
+}
+}
+
+BigInt::BigInt(unsigned long long value)
+{
+    while (value != 0)
+    {
+        limbs.push_back((uint32_t) value);
+        value >>= 32;
+    }
+}
+
+void BigInt::trim()
+{
+    trimLimbs(limbs);
+}
+
+bool BigInt::isZero() const
+{
+    return limbs.empty();
+}
+
+size_t BigInt::numLimbs() const
+{
+    return limbs.size();
+}
+
+BigInt& BigInt::operator+=(const BigInt& other)
+{
+    limbs = addLimbs(limbs.data(), limbs.size(), other.limbs.data(), other.limbs.size());
+    return *this;
+}
+
+BigInt& BigInt::operator-=(const BigInt& other)
+{
+    if (*this < other)
+        throw invalid_argument("BigInt: subtraction would be negative");
+    subtractInPlace(limbs, other.limbs);
+    return *this;
+}
+
+BigInt& BigInt::operator*=(uint32_t factor)
+{
+    uint64_t carry = 0;
+    for (size_t i = 0; i < limbs.size(); i++)
+    {
+        carry += (uint64_t) limbs[i] * factor;
+        limbs[i] = (uint32_t) carry;
+        carry >>= 32;
+    }
+    if (carry != 0)
+        limbs.push_back((uint32_t) carry);
+    trim();
+    return *this;
+}
+
+BigInt& BigInt::operator*=(const BigInt& other)
+{
+    limbs = multiply(limbs.data(), limbs.size(), other.limbs.data(), other.limbs.size());
+    return *this;
+}
+
+uint32_t BigInt::divideSmall(uint32_t divisor)
+{
+    uint64_t remainder = 0;
+    for (size_t i = limbs.size(); i-- > 0;)
+    {
+        uint64_t cur = (remainder << 32) | limbs[i];
+        limbs[i] = (uint32_t) (cur / divisor);
+        remainder = cur % divisor;
+    }
+    trim();
+    return (uint32_t) remainder;
+}
+
+bool BigInt::operator==(const BigInt& other) const
+{
+    return limbs == other.limbs;
+}
+
+bool BigInt::operator!=(const BigInt& other) const
+{
+    return limbs != other.limbs;
+}
+
+bool BigInt::operator<(const BigInt& other) const
+{
+    if (limbs.size() != other.limbs.size())
+        return limbs.size() < other.limbs.size();
+    return lexicographical_compare(limbs.rbegin(), limbs.rend(),
+            other.limbs.rbegin(), other.limbs.rend());
+}
+
+string BigInt::toString() const
+{
+    if (isZero())
+        return "0";
+
+    // Extract base 10^9 chunks, least significant first.
+    BigInt value = *this;
+    vector<uint32_t> chunks;
+    while (!value.isZero())
+        chunks.push_back(value.divideSmall(1000000000));
+
+    string result = to_string(chunks.back());
+    for (size_t i = chunks.size() - 1; i-- > 0;)
+    {
+        string chunk = to_string(chunks[i]);
+        result += string(9 - chunk.size(), '0') + chunk;
+    }
+    return result;
+}
+
+BigInt operator+(BigInt a, const BigInt& b)
+{
+    a += b;
+    return a;
+}
+
+BigInt operator*(const BigInt& a, const BigInt& b)
+{
+    BigInt result;
+    result.limbs = multiply(a.limbs.data(), a.limbs.size(), b.limbs.data(), b.limbs.size());
+    return result;
+}
@@ -0,0 +1,63 @@
+/*
+ * BigInt.h
+ */
+
+#ifndef BIGINT_H_
+#define BIGINT_H_
+
+#include "Defs.h"
+#include <cstdint>
+#include <vector>
+
+/* Inteiro nao negativo de precisao arbitraria.
+ * Os digitos estao na base 2^32, do menos para o mais significativo.
+ * A multiplicacao usa Karatsuba quando ambos os operandos sao grandes.
+ * */
+class BigInt
+{
+    vector<uint32_t> limbs;
+
+    void trim();
+
+public:
+    BigInt(unsigned long long value = 0);
+
+    bool isZero() const;
+
+    /* Numero de digitos na base 2^32 */
+    size_t numLimbs() const;
+
+    BigInt& operator+=(const BigInt& other);
+
+    /* Subtrai other, que nao pode ser maior que este valor */
+    BigInt& operator-=(const BigInt& other);
+    BigInt& operator*=(uint32_t factor);
+    BigInt& operator*=(const BigInt& other);
+
+    /* Divide pelo valor indicado (> 0) e devolve o resto */
+    uint32_t divideSmall(uint32_t divisor);
+
+    bool operator==(const BigInt& other) const;
+    bool operator!=(const BigInt& other) const;
+    bool operator<(const BigInt& other) const;
+
+    /* Representacao decimal, por exemplo "3628800" */
+    string toString() const;
+
+    friend BigInt operator+(BigInt a, const BigInt& b);
+    friend BigInt operator*(const BigInt& a, const BigInt& b);
+};
+
+/* BigInt como anel para as tabelas genericas (StirlingTable, ...) */
+struct BigIntRing
+{
+    typedef BigInt value_type;
+
+    BigInt zero() const { return BigInt(0); }
+    BigInt one() const { return BigInt(1); }
+    void add(BigInt &a, const BigInt &b) const { a += b; }
+    void sub(BigInt &a, const BigInt &b) const { a -= b; }
+    BigInt mulSmall(const BigInt &a, uint32_t k) const { BigInt r = a; r *= k; return r; }
+};
+
+#endif /* BIGINT_H_ */
@@ -0,0 +1,87 @@
+/*
+ * Binomial.cpp
+ */
+
+#include "Binomial.h"
+#include "ModArith.h"
+#include <stdexcept>
+
+BinomialModP::BinomialModP(int maxN, uint32_t p) : p(p)
+{
+    // Validate before sizing the tables, so a bad maxN never allocates.
+    if (maxN < 0 || (uint32_t) maxN >= p)
+        throw invalid_argument("BinomialModP: maxN must be in [0, p)");
+    fact.resize(maxN + 1);
+    invFact.resize(maxN + 1);
+
+    fact[0] = 1 % p;
+    for (int i = 1; i <= maxN; i++)
+        fact[i] = mulMod(fact[i - 1], i, p);
+
+    // One modular inverse, then 1/(i-1)! = i * 1/i! going down.
+    invFact[maxN] = invMod(fact[maxN], p);
+    for (int i = maxN; i > 0; i--)
+        invFact[i - 1] = mulMod(invFact[i], i, p);
+}
+
+void BinomialModP::checkRange(int n) const
+{
+    if (n < 0 || n > getMaxN())
+        throw out_of_range("BinomialModP: n outside the precomputed range");
+}
+
+int BinomialModP::getMaxN() const
+{
+    return (int) fact.size() - 1;
+}
+
+uint32_t BinomialModP::getModulus() const
+{
+    return p;
+}
+
+uint32_t BinomialModP::factorial(int n) const
+{
+    checkRange(n);
+    return fact[n];
+}
+
+uint32_t BinomialModP::nCr(int n, int r) const
+{
+    checkRange(n);
+    if (r < 0 || r > n)
+        return 0;
+    return mulMod(fact[n], mulMod(invFact[r], invFact[n - r], p), p);
+}
+
+uint32_t BinomialModP::nPr(int n, int r) const
+{
+    checkRange(n);
+    if (r < 0 || r > n)
+        return 0;
+    return mulMod(fact[n], invFact[n - r], p);
+}
+
+uint32_t BinomialModP::multinomial(const vector<int> &parts) const
+{
+    long long total = 0;
+    uint32_t result = 1 % p;
+    for (int k : parts)
+    {
+        checkRange(k);
+        total += k;
+        result = mulMod(result, invFact[k], p);
+    }
+    if (total > getMaxN())
+        throw out_of_range("BinomialModP: n outside the precomputed range");
+    return mulMod(result, fact[total], p);
+}
+
+vector<uint32_t> BinomialModP::nCr(const vector<pair<int, int> > &queries) const
+{
+    vector<uint32_t> answers;
+    answers.reserve(queries.size());
+    for (const pair<int, int> &query : queries)
+        answers.push_back(nCr(query.first, query.second));
+    return answers;
+}
@@ -0,0 +1,49 @@
+/*
+ * Binomial.h
+ */
+
+#ifndef BINOMIAL_H_
+#define BINOMIAL_H_
+
+#include "Defs.h"
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/* Servico de consultas combinatorias modulo um primo p.
+ * Os factoriais ate maxN e os seus inversos sao calculados uma vez na
+ * construcao (um unico inverso modular, o resto numa passagem linear);
+ * depois nCr e nPr custam O(1) e o multinomial O(numero de partes).
+ * maxN tem de ser menor que p. Consultas com n > maxN lancam out_of_range.
+ * */
+class BinomialModP
+{
+    uint32_t p;
+    vector<uint32_t> fact;
+    vector<uint32_t> invFact;
+
+    void checkRange(int n) const;
+
+public:
+    BinomialModP(int maxN, uint32_t p = 1000000007);
+
+    int getMaxN() const;
+    uint32_t getModulus() const;
+
+    /* n! mod p */
+    uint32_t factorial(int n) const;
+
+    /* C(n,r) mod p; 0 se r < 0 ou r > n */
+    uint32_t nCr(int n, int r) const;
+
+    /* n! / (n-r)! mod p; 0 se r < 0 ou r > n */
+    uint32_t nPr(int n, int r) const;
+
+    /* (k1 + k2 + ...)! / (k1! k2! ...) mod p */
+    uint32_t multinomial(const vector<int> &parts) const;
+
+    /* Responde a um lote de consultas C(n,r), pela ordem dada */
+    vector<uint32_t> nCr(const vector<pair<int, int> > &queries) const;
+};
+
+#endif /* BINOMIAL_H_ */
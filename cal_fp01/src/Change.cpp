@@ -3,41 +3,282 @@
  */
 
 #include "Change.h"
-#include <cstring>
+#include "ChangeKernel.h"
+#include <algorithm>
+#include <climits>
+#include <mutex>
+#include <stdexcept>
 
-string calcChange(int m, int numCoins, int *coinValues)
+namespace
 {
-    int minCoins[m + 1];
-    minCoins[0] = 0;
-    for (int i = 1; i < m + 1; i++)
+const int NO_CHANGE = INT_MAX / 2;
+
+/* Number of coins the greedy algorithm uses for x (coins in decreasing order) */
+long long greedyCount(const vector<long long> &coins, long long x)
+{
+    long long count = 0;
+    for (long long c : coins)
     {
-        minCoins[i] = 2000;
+        count += x / c;
+        x %= c;
     }
-    if( m == 0)
-        return "";
-    if(m < coinValues[0])
-        return "-";
-    int lastCoin[m + 1];
-    memset(lastCoin, 0, (m+1) * sizeof(int));
-    for(int i = 0; i < numCoins; i++)
+    return count;
+}
+}
+
+string calcChange(int m, int numCoins, int *coinValues)
+{
+    return calcChange(m, numCoins, coinValues, nullptr);
+}
+
+string calcChange(int m, int numCoins, int *coinValues, ChangeStrategy *strategy)
+{
+    CoinSystem system(numCoins, coinValues, m);
+    if (strategy != nullptr)
+        *strategy = system.getStrategy();
+    return system.calcChange(m);
+}
+
+string calcChangeBounded(int m, int numCoins, int *coinValues, int *coinCounts)
+{
+    vector<int> best(m + 1, NO_CHANGE), previous(m + 1);
+    vector<int> used((size_t) numCoins * (m + 1), 0);
+    vector<int> window(m + 1);
+    best[0] = 0;
+
+    for (int i = 0; i < numCoins; i++)
     {
-        for(int k = coinValues[i]; k <= m; k++)
+        int c = coinValues[i];
+        int limit = coinCounts[i];
+        int *usedHere = &used[(size_t) i * (m + 1)];
+        previous.swap(best);
+
+        // For amounts r, r + c, r + 2c, ... the best with j coins of value c is
+        // min over t in [j - limit, j] of previous[r + t*c] + (j - t), so keep
+        // the t with the smallest previous[r + t*c] - t in a monotone deque.
+        for (int r = 0; r < c && r <= m; r++)
         {
-            if( 1 + minCoins[k - coinValues[i]] < minCoins[k])
+            int front = 0, back = 0;
+            for (int j = 0, x = r; x <= m; j++, x += c)
             {
-                minCoins[k] = 1 + minCoins[k - coinValues[i]];
-                lastCoin[k] = i;
+                int key = previous[x] - j;
+                while (back > front && previous[r + window[back - 1] * c] - window[back - 1] >= key)
+                    back--;
+                window[back++] = j;
+                while (window[front] < j - limit)
+                    front++;
 
+                int t = window[front];
+                int candidate = previous[r + t * c];
+                if (candidate >= NO_CHANGE)
+                {
+                    best[x] = NO_CHANGE;
+                    continue;
+                }
+                best[x] = candidate + j - t;
+                usedHere[x] = j - t;
             }
         }
     }
 
+    if (best[m] >= NO_CHANGE)
+        return "-";
+    vector<int> counts(numCoins, 0);
+    int amount = m;
+    for (int i = numCoins - 1; i >= 0; i--)
+    {
+        counts[i] = used[(size_t) i * (m + 1) + amount];
+        amount -= counts[i] * coinValues[i];
+    }
+    return formatChange(numCoins, coinValues, counts.data());
+}
+
+bool calcChangeCounts(int m, int numCoins, int *coinValues, int *counts)
+{
+    return CoinSystem(numCoins, coinValues, m).calcChangeCounts(m, counts);
+}
+
+string formatChange(int numCoins, const int *coinValues, const int *counts)
+{
+    size_t length = 0;
+    for (int i = 0; i < numCoins; i++)
+        length += counts[i] * (to_string(coinValues[i]).size() + 1);
+
     string change;
+    change.reserve(length);
+    for (int i = numCoins - 1; i >= 0; i--)
+    {
+        string coin = to_string(coinValues[i]) + ";";
+        for (int n = 0; n < counts[i]; n++)
+            change += coin;
+    }
+    return change;
+}
+
+bool isCanonical(int numCoins, int *coinValues)
+{
+    if (numCoins == 0 || coinValues[0] != 1)
+        return false;
+
+    vector<long long> coins(coinValues, coinValues + numCoins);
+    reverse(coins.begin(), coins.end());
+
+    // Pearson: the smallest counterexample, if any, is the greedy solution
+    // for coins[i - 1] - 1 truncated after coin j, plus one coin j.
+    for (int i = 1; i < numCoins; i++)
+    {
+        vector<long long> greedy(numCoins, 0);
+        long long rest = coins[i - 1] - 1;
+        for (int k = 0; k < numCoins; k++)
+        {
+            greedy[k] = rest / coins[k];
+            rest %= coins[k];
+        }
+
+        long long value = 0, count = 0;
+        for (int j = 0; j < numCoins; j++)
+        {
+            value += greedy[j] * coins[j];
+            count += greedy[j];
+            if (j >= i && greedyCount(coins, value + coins[j]) > count + 1)
+                return false;
+        }
+    }
+    return true;
+}
+
+CoinSystem::CoinSystem(int numCoins, int *coinValues, int maxAmount)
+    : coinValues(coinValues, coinValues + numCoins),
+      strategy(isCanonical(numCoins, coinValues) ? GREEDY_CHANGE : DYNAMIC_CHANGE)
+{
+    build(strategy == GREEDY_CHANGE ? 0 : maxAmount);
+}
+
+void CoinSystem::build(int maxAmount)
+{
+    minCoins.assign(maxAmount + 1, NO_CHANGE);
+    minCoins[0] = 0;
+    lastCoin.assign(maxAmount + 1, 0);
+    for (size_t i = 0; i < coinValues.size(); i++)
+        relaxCoin(minCoins.data(), lastCoin.data(), maxAmount, coinValues[i], i);
+}
+
+void CoinSystem::ensureAmount(int m)
+{
+    if (strategy == GREEDY_CHANGE)
+        return;
+    {
+        shared_lock<shared_timed_mutex> lock(tableMutex);
+        if (m < (int) minCoins.size())
+            return;
+    }
+    unique_lock<shared_timed_mutex> lock(tableMutex);
+    long long doubled = 2LL * ((long long) minCoins.size() - 1);
+    if (m >= (int) minCoins.size())
+        build((int) max<long long>(m, min<long long>(doubled, INT_MAX - 1)));
+}
+
+ChangeStrategy CoinSystem::getStrategy() const
+{
+    return strategy;
+}
+
+int CoinSystem::getMaxAmount() const
+{
+    shared_lock<shared_timed_mutex> lock(tableMutex);
+    return (int) minCoins.size() - 1;
+}
+
+int CoinSystem::countCoins(int m)
+{
+    if (strategy == GREEDY_CHANGE)
+    {
+        vector<long long> coins(coinValues.rbegin(), coinValues.rend());
+        return (int) greedyCount(coins, m);
+    }
+    ensureAmount(m);
+    shared_lock<shared_timed_mutex> lock(tableMutex);
+    return minCoins[m] == NO_CHANGE ? -1 : minCoins[m];
+}
+
+string CoinSystem::calcChange(int m)
+{
+    vector<int> counts(coinValues.size());
+    if (!calcChangeCounts(m, counts.data()))
+        return "-";
+    return formatChange(coinValues.size(), coinValues.data(), counts.data());
+}
+
+bool CoinSystem::calcChangeCounts(int m, int *counts)
+{
+    fill(counts, counts + coinValues.size(), 0);
+    if (strategy == GREEDY_CHANGE)
+    {
+        for (size_t i = coinValues.size(); i-- > 0;)
+        {
+            counts[i] = m / coinValues[i];
+            m %= coinValues[i];
+        }
+        return true;
+    }
+
+    ensureAmount(m);
+    shared_lock<shared_timed_mutex> lock(tableMutex);
+    if (minCoins[m] == NO_CHANGE)
+        return false;
     while (m > 0)
     {
-        change += to_string(coinValues[lastCoin[m]]) + ";";
+        counts[lastCoin[m]]++;
         m -= coinValues[lastCoin[m]];
     }
-    return change;
+    return true;
+}
+
+long long CoinSystem::getLargeAmountThreshold() const
+{
+    size_t n = coinValues.size();
+    if (n == 1)
+        return coinValues[0];
+    return (long long) coinValues[n - 1] * coinValues[n - 2];
 }
 
+ChangeHistogram CoinSystem::calcChangeHistogram(unsigned long long m)
+{
+    ChangeHistogram result = { true, vector<unsigned long long>(coinValues.size(), 0) };
+    if (strategy == GREEDY_CHANGE)
+    {
+        for (size_t i = coinValues.size(); i-- > 0;)
+        {
+            result.counts[i] = m / coinValues[i];
+            m %= coinValues[i];
+        }
+        return result;
+    }
+
+    // Above the threshold every optimal solution contains the largest coin,
+    // so take as many as needed to bring the amount just below it.
+    unsigned long long threshold = getLargeAmountThreshold();
+    unsigned long long largest = coinValues.back();
+    if (m >= threshold)
+    {
+        unsigned long long taken = (m - threshold) / largest + 1;
+        result.counts.back() = taken;
+        m -= taken * largest;
+    }
+
+    // The remainder indexes the int-sized table; coin systems whose threshold
+    // exceeds it would need a table of several gigabytes anyway.
+    if (m >= (unsigned long long) INT_MAX)
+        throw invalid_argument("calcChangeHistogram: remainder does not fit the change table");
+    int amount = (int) m;
+    ensureAmount(amount);
+    shared_lock<shared_timed_mutex> lock(tableMutex);
+    if (minCoins[amount] == NO_CHANGE)
+        return { false, vector<unsigned long long>(coinValues.size(), 0) };
+    while (amount > 0)
+    {
+        result.counts[lastCoin[amount]]++;
+        amount -= coinValues[lastCoin[amount]];
+    }
+    return result;
+}
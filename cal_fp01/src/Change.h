@@ -6,6 +6,8 @@
 #define CHANGE_H_
 
 #include "Defs.h"
+#include <shared_mutex>
+#include <vector>
 
 /* Calcula o troco num determinado montante m, utilizando um nmero mnimo
  * de moedas de valores unitrios indicados (coinValues).
@@ -17,4 +19,98 @@
  * */
 string calcChange(int m, int numCoins, int *coinValues);
 
+/* Igual a calcChange, mas com um numero limitado de moedas de cada valor:
+ * coinCounts[i] indica quantas moedas de valor coinValues[i] existem.
+ * Para cada moeda, percorre as classes de resto modulo o seu valor com uma
+ * fila monotona (minimo em janela deslizante), em O(m * numCoins) no total.
+ * */
+string calcChangeBounded(int m, int numCoins, int *coinValues, int *coinCounts);
+
+/* Estrategia usada para calcular o troco */
+enum ChangeStrategy { GREEDY_CHANGE, DYNAMIC_CHANGE };
+
+/* Igual a calcChange, mas escolhe o algoritmo guloso (O(numCoins)) se o sistema
+ * de moedas for canonico e a programacao dinamica caso contrario.
+ * Se strategy nao for nulo, indica a estrategia usada.
+ * */
+string calcChange(int m, int numCoins, int *coinValues, ChangeStrategy *strategy);
+
+/* Indica se o sistema de moedas (por ordem crescente) e canonico, isto e, se o
+ * algoritmo guloso da sempre o numero minimo de moedas.
+ * Usa a pesquisa de contra-exemplos de Pearson, O(numCoins^3).
+ * Um sistema sem moeda de valor 1 nunca e canonico.
+ * */
+bool isCanonical(int numCoins, int *coinValues);
+
+/* Versao estruturada de calcChange: escreve em counts (array com numCoins
+ * posicoes, fornecido por quem chama) o numero de moedas de cada valor.
+ * Devolve false se o montante for impossivel.
+ * */
+bool calcChangeCounts(int m, int numCoins, int *coinValues, int *counts);
+
+/* Formata contagens de moedas como calcChange: "5;2;2;" (valores decrescentes).
+ * Reserva a string de uma so vez.
+ * */
+string formatChange(int numCoins, const int *coinValues, const int *counts);
+
+/* Troco representado por contagens: counts[i] e o numero de moedas de valor
+ * coinValues[i]. possible e falso se o montante nao puder ser pago.
+ * */
+struct ChangeHistogram
+{
+    bool possible;
+    vector<unsigned long long> counts;
+};
+
+/* Sistema de moedas reutilizavel para responder a muitos montantes.
+ * Se o sistema for canonico usa o algoritmo guloso e nao constroi tabela.
+ * A tabela de programacao dinamica e construida uma unica vez (no heap) ate
+ * maxAmount e so volta a ser construida, com o dobro do tamanho, quando surge
+ * um montante maior. Cada consulta custa O(numero de moedas do troco).
+ * Pode ser partilhado entre threads: as consultas so bloqueiam durante um
+ * crescimento da tabela.
+ * */
+class CoinSystem
+{
+    vector<int> coinValues;
+    ChangeStrategy strategy;
+    vector<int> minCoins;
+    vector<int> lastCoin;
+    mutable shared_timed_mutex tableMutex;
+
+    void build(int maxAmount);
+    void ensureAmount(int m);
+
+public:
+    /* coinValues deve estar ordenado por ordem crescente */
+    CoinSystem(int numCoins, int *coinValues, int maxAmount = 0);
+
+    /* Estrategia escolhida na construcao */
+    ChangeStrategy getStrategy() const;
+
+    /* Montante maximo coberto pela tabela atual */
+    int getMaxAmount() const;
+
+    /* Numero minimo de moedas para o montante m, ou -1 se for impossivel */
+    int countCoins(int m);
+
+    /* Mesmo formato de calcChange: "5;2;2;", "" para m = 0 e "-" se for impossivel */
+    string calcChange(int m);
+
+    /* Escreve em counts (uma posicao por moeda) o troco de m, sem alocar memoria
+     * para o resultado; devolve false se for impossivel */
+    bool calcChangeCounts(int m, int *counts);
+
+    /* Montante a partir do qual o troco otimo inclui sempre a maior moeda
+     * (produto das duas maiores moedas, ou a propria moeda se so houver uma) */
+    long long getLargeAmountThreshold() const;
+
+    /* Troco para montantes de 64 bits. Acima do limiar retira moedas da maior
+     * denominacao, pelo que a tabela nunca ultrapassa o dobro do limiar.
+     * Lanca invalid_argument se o resto abaixo do limiar nao couber num int
+     * (sistemas nao canonicos com moedas muito grandes).
+     * */
+    ChangeHistogram calcChangeHistogram(unsigned long long m);
+};
+
 #endif /* CHANGE_H_ */
@@ -0,0 +1,121 @@
+/*
+ * ChangeKernel.cpp
+ */
+
+#include "ChangeKernel.h"
+#include "Cpu.h"
+
+namespace
+{
+void relaxRange(int *minCoins, int *lastCoin, int from, int m, int coin, int coinIndex)
+{
+    for (int k = from; k <= m; k++)
+    {
+        if (1 + minCoins[k - coin] < minCoins[k])
+        {
+            minCoins[k] = 1 + minCoins[k - coin];
+            lastCoin[k] = coinIndex;
+        }
+    }
+}
+
+#ifdef HAVE_X86_SIMD
+__attribute__((target("avx2")))
+int relaxCoinAvx2(int *minCoins, int *lastCoin, int m, int coin, int coinIndex)
+{
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i index = _mm256_set1_epi32(coinIndex);
+    int k = coin;
+    for (; k + 7 <= m; k += 8)
+    {
+        __m256i candidate = _mm256_add_epi32(one,
+                _mm256_loadu_si256((const __m256i *) (minCoins + k - coin)));
+        __m256i current = _mm256_loadu_si256((const __m256i *) (minCoins + k));
+        __m256i better = _mm256_cmpgt_epi32(current, candidate);
+        __m256i last = _mm256_loadu_si256((const __m256i *) (lastCoin + k));
+        _mm256_storeu_si256((__m256i *) (minCoins + k), _mm256_min_epi32(current, candidate));
+        _mm256_storeu_si256((__m256i *) (lastCoin + k), _mm256_blendv_epi8(last, index, better));
+    }
+    return k;
+}
+
+__attribute__((target("sse4.1")))
+int relaxCoinSse41(int *minCoins, int *lastCoin, int m, int coin, int coinIndex)
+{
+    const __m128i one = _mm_set1_epi32(1);
+    const __m128i index = _mm_set1_epi32(coinIndex);
+    int k = coin;
+    for (; k + 3 <= m; k += 4)
+    {
+        __m128i candidate = _mm_add_epi32(one,
+                _mm_loadu_si128((const __m128i *) (minCoins + k - coin)));
+        __m128i current = _mm_loadu_si128((const __m128i *) (minCoins + k));
+        __m128i better = _mm_cmpgt_epi32(current, candidate);
+        __m128i last = _mm_loadu_si128((const __m128i *) (lastCoin + k));
+        _mm_storeu_si128((__m128i *) (minCoins + k), _mm_min_epi32(current, candidate));
+        _mm_storeu_si128((__m128i *) (lastCoin + k), _mm_blendv_epi8(last, index, better));
+    }
+    return k;
+}
+#endif
+
+enum Kernel { SCALAR, SSE41, AVX2 };
+
+/* A vector load of minCoins[k - coin ..] must only read positions that are
+ * already final, so coin >= vector width. When coin is not a multiple of
+ * the width the load straddles two recent stores and store forwarding
+ * stalls, which costs more than the scalar loop until the distance is
+ * about four vectors. */
+Kernel kernelFor(int coin)
+{
+#ifdef HAVE_X86_SIMD
+    if ((coin >= 8 && coin % 8 == 0) || coin >= 32)
+        if (cpuHasAvx2())
+            return AVX2;
+    if ((coin >= 8 && coin % 4 == 0) || coin >= 16)
+        if (cpuHasSse41())
+            return SSE41;
+#else
+    (void) coin;
+#endif
+    return SCALAR;
+}
+}
+
+void relaxCoinScalar(int *minCoins, int *lastCoin, int m, int coin, int coinIndex)
+{
+    relaxRange(minCoins, lastCoin, coin, m, coin, coinIndex);
+}
+
+const char *relaxCoinPath(int coin)
+{
+    switch (kernelFor(coin))
+    {
+    case AVX2:
+        return "avx2";
+    case SSE41:
+        return "sse4.1";
+    default:
+        return "scalar";
+    }
+}
+
+void relaxCoin(int *minCoins, int *lastCoin, int m, int coin, int coinIndex)
+{
+    int done = coin;
+#ifdef HAVE_X86_SIMD
+    switch (kernelFor(coin))
+    {
+    case AVX2:
+        done = relaxCoinAvx2(minCoins, lastCoin, m, coin, coinIndex);
+        break;
+    case SSE41:
+        done = relaxCoinSse41(minCoins, lastCoin, m, coin, coinIndex);
+        break;
+    default:
+        break;
+    }
+#endif
+    // Scalar tail (or the whole range for small coins).
+    relaxRange(minCoins, lastCoin, done, m, coin, coinIndex);
+}
@@ -0,0 +1,26 @@
+/*
+ * ChangeKernel.h
+ */
+
+#ifndef CHANGEKERNEL_H_
+#define CHANGEKERNEL_H_
+
+#include "Defs.h"
+
+/* Passo da programacao dinamica do troco para uma moeda:
+ * minCoins[k] = min(minCoins[k], 1 + minCoins[k - coin]), para coin <= k <= m,
+ * guardando coinIndex em lastCoin[k] sempre que ha melhoria estrita.
+ * A dependencia entre posicoes tem distancia coin, por isso, quando o
+ * processador suporta, usa AVX2 (8 posicoes) ou SSE4.1 (4 posicoes) para
+ * moedas suficientemente grandes; as pequenas seguem pelo caminho escalar.
+ * minCoins nao pode ter valores perto de INT_MAX (1 + valor nao pode transbordar).
+ * */
+void relaxCoin(int *minCoins, int *lastCoin, int m, int coin, int coinIndex);
+
+/* Versao escalar de relaxCoin */
+void relaxCoinScalar(int *minCoins, int *lastCoin, int m, int coin, int coinIndex);
+
+/* Nome do caminho que relaxCoin usa para a moeda indicada ("avx2", "sse4.1" ou "scalar") */
+const char *relaxCoinPath(int coin);
+
+#endif /* CHANGEKERNEL_H_ */
@@ -0,0 +1,136 @@
+/*
+ * ConstTables.h
+ */
+
+#ifndef CONSTTABLES_H_
+#define CONSTTABLES_H_
+
+#include <stdexcept>
+#include <vector>
+
+/* Tabelas calculadas em tempo de compilacao (constexpr) para valores pequenos.
+ * T e o tipo inteiro e N o maior n guardado; cabe a quem escolhe T garantir
+ * que os valores ate N nao transbordam (com long long: N <= 20 para o
+ * factorial e N <= 25 para Stirling e Bell).
+ * */
+
+/* n! para 0 <= n <= N */
+template <class T, int N>
+struct FactorialTable
+{
+    T values[N + 1];
+
+    constexpr FactorialTable() : values()
+    {
+        values[0] = 1;
+        for (int i = 1; i <= N; i++)
+            values[i] = values[i - 1] * i;
+    }
+
+    constexpr T operator[](int n) const { return values[n]; }
+};
+
+/* s(n,k) para 0 <= k <= n <= N */
+template <class T, int N>
+struct StirlingConstTable
+{
+    T values[N + 1][N + 1];
+
+    constexpr StirlingConstTable() : values()
+    {
+        values[0][0] = 1;
+        for (int n = 1; n <= N; n++)
+            for (int k = 1; k <= n; k++)
+                values[n][k] = k * values[n - 1][k] + values[n - 1][k - 1];
+    }
+
+    constexpr T operator()(int n, int k) const { return values[n][k]; }
+};
+
+/* b(n) para 0 <= n <= N */
+template <class T, int N>
+struct BellTable
+{
+    T values[N + 1];
+
+    constexpr BellTable() : values()
+    {
+        StirlingConstTable<T, N> stirling;
+        for (int n = 0; n <= N; n++)
+            for (int k = 0; k <= n; k++)
+                values[n] += stirling(n, k);
+    }
+
+    constexpr T operator[](int n) const { return values[n]; }
+};
+
+/* n! por consulta a tabela se n <= N; acima disso continua o produto em tempo de execucao.
+ * Lanca invalid_argument se n < 0 */
+template <class T = long long, int N = 20>
+T factorialLookup(int n)
+{
+    static constexpr FactorialTable<T, N> table;
+    if (n < 0)
+        throw std::invalid_argument("factorialLookup: n must be non-negative");
+    if (n <= N)
+        return table[n];
+    T result = table[N];
+    for (int i = N + 1; i <= n; i++)
+        result *= i;
+    return result;
+}
+
+/* s(n,k) por consulta a tabela se n <= N; acima disso continua a recorrencia a partir da linha N */
+template <class T = long long, int N = 25>
+T stirlingLookup(int n, int k)
+{
+    static constexpr StirlingConstTable<T, N> table;
+    if (k < 0 || k > n)
+        return 0;
+    if (n <= N)
+        return table(n, k);
+
+    std::vector<T> row(k + 1, 0);
+    for (int j = 0; j <= k && j <= N; j++)
+        row[j] = table(N, j);
+    for (int i = N + 1; i <= n; i++)
+        for (int j = k; j >= 1; j--)
+            row[j] = j * row[j] + row[j - 1];
+    return row[k];
+}
+
+/* b(n) por consulta a tabela se n <= N; acima disso continua a recorrencia de
+ * Stirling a partir da linha N e soma a linha n. Lanca invalid_argument se n < 0 */
+template <class T = long long, int N = 25>
+T bellLookup(int n)
+{
+    static constexpr BellTable<T, N> table;
+    static constexpr StirlingConstTable<T, N> stirling;
+    if (n < 0)
+        throw std::invalid_argument("bellLookup: n must be non-negative");
+    if (n <= N)
+        return table[n];
+
+    std::vector<T> row(n + 1, 0);
+    for (int j = 0; j <= N; j++)
+        row[j] = stirling(N, j);
+    for (int i = N + 1; i <= n; i++)
+        for (int j = i; j >= 1; j--)
+            row[j] = j * row[j] + row[j - 1];
+    T sum = 0;
+    for (int j = 0; j <= n; j++)
+        sum += row[j];
+    return sum;
+}
+
+static_assert(FactorialTable<long long, 20>()[0] == 1, "0! = 1");
+static_assert(FactorialTable<long long, 20>()[10] == 3628800, "10! = 3628800");
+static_assert(FactorialTable<long long, 20>()[20] == 2432902008176640000LL, "20!");
+static_assert(StirlingConstTable<long long, 25>()(9, 3) == 3025, "s(9,3) = 3025");
+static_assert(StirlingConstTable<long long, 25>()(10, 6) == 22827, "s(10,6) = 22827");
+static_assert(StirlingConstTable<long long, 25>()(5, 0) == 0, "s(5,0) = 0");
+static_assert(BellTable<long long, 25>()[6] == 203, "b(6) = 203");
+static_assert(BellTable<long long, 25>()[15] == 1382958545, "b(15) = 1382958545");
+static_assert(BellTable<long long, 25>()[25] == 4638590332229999353LL, "b(25)");
+
+#endif /* CONSTTABLES_H_ */
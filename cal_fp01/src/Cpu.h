@@ -0,0 +1,35 @@
+/*
+ * Cpu.h
+ */
+
+#ifndef CPU_H_
+#define CPU_H_
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define HAVE_X86_SIMD
+#include <immintrin.h>
+#endif
+
+/* Indica se o processador suporta AVX2 (sempre falso fora de x86) */
+inline bool cpuHasAvx2()
+{
+#ifdef HAVE_X86_SIMD
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+/* Indica se o processador suporta SSE4.1 (sempre falso fora de x86) */
+inline bool cpuHasSse41()
+{
+#ifdef HAVE_X86_SIMD
+    static const bool supported = __builtin_cpu_supports("sse4.1");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+#endif /* CPU_H_ */
@@ -3,6 +3,11 @@
  */
 
 #include "Factorial.h"
+#include "Memo.h"
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
 
 int factorialRecurs(int n)
 {
@@ -15,9 +20,155 @@ int factorialRecurs(int n)
 int factorialDinam(int n)
 {
     int fact = n--;
-    for(n; n>=2; n--)
+    for(; n>=2; n--)
     {
         fact*=n;
     }
 	return fact;
 }
+
+namespace
+{
+/* 12! is the largest factorial that fits in an int */
+const int MAX_INT_FACTORIAL = 12;
+
+MemoTable<int> factorialMemo(0, MEMO_LINEAR);
+}
+
+int factorialMemoized(int n)
+{
+    if(n < 0 || n > MAX_INT_FACTORIAL)
+        throw out_of_range("factorialMemoized: n must be in [0, 12]");
+    if(n <= 1)
+        return 1;
+    return memoize(factorialMemo, n, [n]() { return n * factorialMemoized(n - 1); });
+}
+
+namespace
+{
+const int LEAF_SIZE = 32;
+
+/* The most recently used factorials, at most MAX_CACHED_FACTORIALS of them,
+ * so memory stays bounded while a sweep still reuses its neighbours. */
+const size_t MAX_CACHED_FACTORIALS = 16;
+
+struct CachedFactorial
+{
+    BigInt value;
+    unsigned long long lastUse;
+};
+
+map<int, CachedFactorial> factorialCache;
+unsigned long long factorialCacheClock = 0;
+mutex factorialCacheMutex;
+
+/* Same loop as factorialDinam, but flushing into a BigInt before the
+ * machine-word accumulator overflows. */
+BigInt productLeaf(int lo, int hi)
+{
+    BigInt result(1);
+    uint64_t acc = 1;
+    for (int i = lo; i <= hi; i++)
+    {
+        if (acc > UINT32_MAX / (uint64_t) i)
+        {
+            result *= (uint32_t) acc;
+            acc = 1;
+        }
+        acc *= i;
+    }
+    result *= (uint32_t) acc;
+    return result;
+}
+
+BigInt productRangeParallel(int lo, int hi, unsigned numThreads)
+{
+    int length = hi - lo + 1;
+    if (numThreads < 2 || length < 2 * LEAF_SIZE)
+        return productRange(lo, hi);
+    numThreads = min<unsigned>(numThreads, length / LEAF_SIZE);
+
+    vector<BigInt> partial(numThreads);
+    vector<thread> workers;
+    for (unsigned t = 0; t < numThreads; t++)
+    {
+        int from = lo + (int) ((long long) length * t / numThreads);
+        int to = lo + (int) ((long long) length * (t + 1) / numThreads) - 1;
+        workers.emplace_back([&partial, t, from, to]() {
+            partial[t] = productRange(from, to);
+        });
+    }
+    for (thread &worker : workers)
+        worker.join();
+
+    // Combine the partial products pairwise, keeping the operands balanced.
+    while (partial.size() > 1)
+    {
+        vector<BigInt> next;
+        for (size_t i = 0; i + 1 < partial.size(); i += 2)
+            next.push_back(partial[i] * partial[i + 1]);
+        if (partial.size() % 2 == 1)
+            next.push_back(partial.back());
+        partial.swap(next);
+    }
+    return partial[0];
+}
+}
+
+BigInt productRange(int lo, int hi)
+{
+    if (hi < lo)
+        return BigInt(1);
+    if (hi - lo < LEAF_SIZE)
+        return productLeaf(lo, hi);
+    int mid = lo + (hi - lo) / 2;
+    return productRange(lo, mid) * productRange(mid + 1, hi);
+}
+
+BigInt factorialBig(int n, unsigned numThreads)
+{
+    if (n < 0)
+        throw invalid_argument("factorialBig: n must be >= 0");
+
+    int from = 0;
+    BigInt base(1);
+    {
+        lock_guard<mutex> lock(factorialCacheMutex);
+        auto it = factorialCache.upper_bound(n);
+        if (it != factorialCache.begin())
+        {
+            --it;
+            it->second.lastUse = ++factorialCacheClock;
+            if (it->first == n)
+                return it->second.value;
+            from = it->first;
+            base = it->second.value;
+        }
+    }
+
+    BigInt result = base * productRangeParallel(max(from + 1, 1), n, numThreads);
+
+    lock_guard<mutex> lock(factorialCacheMutex);
+    factorialCache[n] = { result, ++factorialCacheClock };
+    if (factorialCache.size() > MAX_CACHED_FACTORIALS)
+    {
+        auto oldest = factorialCache.begin();
+        for (auto it = factorialCache.begin(); it != factorialCache.end(); ++it)
+            if (it->second.lastUse < oldest->second.lastUse)
+                oldest = it;
+        factorialCache.erase(oldest);
+    }
+    return result;
+}
+
+void clearFactorialCache()
+{
+    lock_guard<mutex> lock(factorialCacheMutex);
+    factorialCache.clear();
+}
+
+size_t factorialCacheSize()
+{
+    lock_guard<mutex> lock(factorialCacheMutex);
+    return factorialCache.size();
+}
@@ -6,6 +6,7 @@
 #define FACTORIAL_H_
 
 #include "Defs.h"
+#include "BigInt.h"
 
 /*Calcula o factorial de um valor de entrada n (>=0) usando recursividade*/
 int factorialRecurs(int n);
@@ -13,5 +14,23 @@ int factorialRecurs(int n);
 /*Calcula o factorial de um valor de entrada n (>=0) usando programao dinmica*/
 int factorialDinam(int n);
 
+/*Calcula o factorial de n (0 <= n <= 12, o maximo que cabe num int) usando recursividade
+ *com memorizacao (MemoTable partilhada). Lanca out_of_range para outros valores*/
+int factorialMemoized(int n);
+
+/*Calcula o produto lo*(lo+1)*...*hi (lo >= 1) por divisao binaria (arvore de produtos)*/
+BigInt productRange(int lo, int hi);
+
+/*Calcula o factorial de n (>=0) com precisao arbitraria.
+ *Os ultimos 16 factoriais usados ficam memorizados (LRU); o maior deles que
+ *nao passe de n serve de ponto de partida, pelo que a memoria fica limitada.
+ *Com numThreads > 1 a arvore de produtos e dividida por varias threads (util para n >= 10^5)*/
+BigInt factorialBig(int n, unsigned numThreads = 1);
+
+/*Esquece os factoriais memorizados por factorialBig*/
+void clearFactorialCache();
+
+/*Numero de factoriais memorizados por factorialBig (no maximo 16)*/
+size_t factorialCacheSize();
 
 #endif /* FACTORIAL_H_ */
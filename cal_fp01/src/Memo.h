@@ -0,0 +1,234 @@
+/*
+ * Memo.h
+ */
+
+#ifndef MEMO_H_
+#define MEMO_H_
+
+#include <cstddef>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+/* Forma das chaves: f(n,k) com 0 <= k <= n (posicao n*(n+1)/2 + k) ou
+ * f(n) com n >= 0 (posicao n; k tem de ser 0) */
+enum MemoShape { MEMO_TRIANGULAR, MEMO_LINEAR };
+
+/* Cache de resultados f(n,k) (ou f(n), ver MemoShape) para memorizar recursoes.
+ * Sem limite (capacity = 0) os valores ficam numa tabela plana que cresce
+ * conforme os n pedidos. Com capacity > 0 guarda no maximo capacity valores
+ * num conjunto fixo de nos, encontrados por um hash map, descartando o usado
+ * ha mais tempo (LRU); a memoria fica limitada por capacity seja qual for n.
+ * Pode ser partilhado entre threads; o calculo em si e feito fora do lock
+ * (ver memoize).
+ * */
+template <class T>
+class MemoTable
+{
+    static const size_t NONE = (size_t) -1;
+
+    MemoShape shape;
+    size_t capacity, count;
+    long long hits, misses;
+    std::mutex tableMutex;
+
+    /* Sem limite: tabela plana indexada pela posicao */
+    std::vector<T> values;
+    std::vector<char> present;
+
+    /* Com limite: nos da lista LRU (mais recente em head) */
+    std::unordered_map<size_t, size_t> nodeOf;
+    std::vector<T> nodeValue;
+    std::vector<size_t> nodeSlot, prev, next;
+    size_t head, tail;
+
+    size_t slot(int n, int k) const
+    {
+        if (shape == MEMO_LINEAR)
+        {
+            if (n < 0 || k != 0)
+                throw std::out_of_range("MemoTable: expected n >= 0 and k == 0");
+            return n;
+        }
+        if (n < 0 || k < 0 || k > n)
+            throw std::out_of_range("MemoTable: expected 0 <= k <= n");
+        return (size_t) n * (n + 1) / 2 + k;
+    }
+
+    void unlink(size_t node)
+    {
+        if (prev[node] != NONE)
+            next[prev[node]] = next[node];
+        else
+            head = next[node];
+        if (next[node] != NONE)
+            prev[next[node]] = prev[node];
+        else
+            tail = prev[node];
+    }
+
+    void pushFront(size_t node)
+    {
+        prev[node] = NONE;
+        next[node] = head;
+        if (head != NONE)
+            prev[head] = node;
+        head = node;
+        if (tail == NONE)
+            tail = node;
+    }
+
+public:
+    /* capacity = 0 significa sem limite */
+    MemoTable(size_t capacity = 0, MemoShape shape = MEMO_TRIANGULAR)
+        : shape(shape), capacity(capacity), count(0), hits(0), misses(0), head(NONE), tail(NONE) {}
+
+    /* Se f(n,k) estiver guardado, copia-o para value e devolve true */
+    bool lookup(int n, int k, T &value)
+    {
+        size_t s = slot(n, k);
+        std::lock_guard<std::mutex> lock(tableMutex);
+        if (capacity == 0)
+        {
+            if (s >= present.size() || !present[s])
+            {
+                misses++;
+                return false;
+            }
+            hits++;
+            value = values[s];
+            return true;
+        }
+
+        auto it = nodeOf.find(s);
+        if (it == nodeOf.end())
+        {
+            misses++;
+            return false;
+        }
+        hits++;
+        unlink(it->second);
+        pushFront(it->second);
+        value = nodeValue[it->second];
+        return true;
+    }
+
+    /* Guarda f(n,k) = value */
+    void store(int n, int k, const T &value)
+    {
+        size_t s = slot(n, k);
+        std::lock_guard<std::mutex> lock(tableMutex);
+        if (capacity == 0)
+        {
+            if (s >= present.size())
+            {
+                size_t size = (shape == MEMO_TRIANGULAR ? slot(n, n) : s) + 1;
+                values.resize(size);
+                present.resize(size, 0);
+            }
+            values[s] = value;
+            if (!present[s])
+            {
+                present[s] = 1;
+                count++;
+            }
+            return;
+        }
+
+        auto it = nodeOf.find(s);
+        if (it != nodeOf.end())
+        {
+            nodeValue[it->second] = value;
+            unlink(it->second);
+            pushFront(it->second);
+            return;
+        }
+        size_t node;
+        if (nodeValue.size() < capacity)
+        {
+            node = nodeValue.size();
+            nodeValue.push_back(value);
+            nodeSlot.push_back(s);
+            prev.push_back(NONE);
+            next.push_back(NONE);
+            count++;
+        }
+        else
+        {
+            node = tail;
+            unlink(node);
+            nodeOf.erase(nodeSlot[node]);
+            nodeValue[node] = value;
+            nodeSlot[node] = s;
+        }
+        nodeOf[s] = node;
+        pushFront(node);
+    }
+
+    /* Numero de valores guardados */
+    size_t size()
+    {
+        std::lock_guard<std::mutex> lock(tableMutex);
+        return count;
+    }
+
+    /* Numero de posicoes com memoria reservada para valores (nunca mais de
+     * capacity quando ha limite) */
+    size_t storageSize()
+    {
+        std::lock_guard<std::mutex> lock(tableMutex);
+        return capacity == 0 ? values.size() : nodeValue.size();
+    }
+
+    long long getHits()
+    {
+        std::lock_guard<std::mutex> lock(tableMutex);
+        return hits;
+    }
+
+    long long getMisses()
+    {
+        std::lock_guard<std::mutex> lock(tableMutex);
+        return misses;
+    }
+
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(tableMutex);
+        values.clear();
+        present.clear();
+        nodeOf.clear();
+        nodeValue.clear();
+        nodeSlot.clear();
+        prev.clear();
+        next.clear();
+        head = tail = NONE;
+        count = 0;
+        hits = misses = 0;
+    }
+};
+
+template <class T>
+const size_t MemoTable<T>::NONE;
+
+/* Devolve f(n,k) da cache ou, se nao estiver la, calcula-o com compute() e guarda-o */
+template <class T, class F>
+T memoize(MemoTable<T> &memo, int n, int k, F compute)
+{
+    T value;
+    if (memo.lookup(n, k, value))
+        return value;
+    value = compute();
+    memo.store(n, k, value);
+    return value;
+}
+
+/* Igual, para funcoes de um so argumento (MemoTable com MEMO_LINEAR) */
+template <class T, class F>
+T memoize(MemoTable<T> &memo, int n, F compute)
+{
+    return memoize(memo, n, 0, compute);
+}
+
+#endif /* MEMO_H_ */
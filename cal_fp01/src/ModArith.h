@@ -0,0 +1,62 @@
+/*
+ * ModArith.h
+ */
+
+#ifndef MODARITH_H_
+#define MODARITH_H_
+
+#include <cstdint>
+
+/* Aritmetica modulo p, com 1 < p < 2^32 (os produtos cabem em 64 bits) */
+
+inline uint32_t addMod(uint32_t a, uint32_t b, uint32_t p)
+{
+    uint64_t sum = (uint64_t) a + b;
+    return (uint32_t) (sum >= p ? sum - p : sum);
+}
+
+inline uint32_t subMod(uint32_t a, uint32_t b, uint32_t p)
+{
+    return a >= b ? a - b : (uint32_t) ((uint64_t) a + p - b);
+}
+
+inline uint32_t mulMod(uint32_t a, uint32_t b, uint32_t p)
+{
+    return (uint32_t) ((uint64_t) a * b % p);
+}
+
+inline uint32_t powMod(uint32_t base, uint64_t exponent, uint32_t p)
+{
+    uint32_t result = 1 % p;
+    base %= p;
+    while (exponent > 0)
+    {
+        if (exponent & 1)
+            result = mulMod(result, base, p);
+        base = mulMod(base, base, p);
+        exponent >>= 1;
+    }
+    return result;
+}
+
+/* Inverso de a modulo p, com p primo e a nao multiplo de p */
+inline uint32_t invMod(uint32_t a, uint32_t p)
+{
+    return powMod(a, p - 2, p);
+}
+
+/* Aneis usados pelas tabelas genericas (StirlingTable, ...) */
+struct ModRing
+{
+    typedef uint32_t value_type;
+    uint32_t p;
+
+    explicit ModRing(uint32_t p) : p(p) {}
+    uint32_t zero() const { return 0; }
+    uint32_t one() const { return 1 % p; }
+    void add(uint32_t &a, const uint32_t &b) const { a = addMod(a, b, p); }
+    void sub(uint32_t &a, const uint32_t &b) const { a = subMod(a, b, p); }
+    uint32_t mulSmall(const uint32_t &a, uint32_t k) const { return mulMod(a, k % p, p); }
+};
+
+#endif /* MODARITH_H_ */
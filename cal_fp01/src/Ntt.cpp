@@ -0,0 +1,106 @@
+/*
+ * Ntt.cpp
+ */
+
+#include "Ntt.h"
+#include "ModArith.h"
+#include <stdexcept>
+
+namespace
+{
+uint32_t primitiveRoot(uint32_t p)
+{
+    vector<uint32_t> factors;
+    uint32_t rest = p - 1;
+    for (uint32_t f = 2; (uint64_t) f * f <= rest; f++)
+    {
+        if (rest % f == 0)
+        {
+            factors.push_back(f);
+            while (rest % f == 0)
+                rest /= f;
+        }
+    }
+    if (rest > 1)
+        factors.push_back(rest);
+
+    for (uint32_t g = 2; g < p; g++)
+    {
+        bool generator = true;
+        for (uint32_t f : factors)
+            if (powMod(g, (p - 1) / f, p) == 1)
+            {
+                generator = false;
+                break;
+            }
+        if (generator)
+            return g;
+    }
+    throw invalid_argument("convolveMod: modulus is not prime");
+}
+
+void ntt(vector<uint32_t> &a, bool inverse, uint32_t p, uint32_t root)
+{
+    size_t n = a.size();
+    for (size_t i = 1, j = 0; i < n; i++)
+    {
+        size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1)
+            j ^= bit;
+        j ^= bit;
+        if (i < j)
+            swap(a[i], a[j]);
+    }
+
+    for (size_t length = 2; length <= n; length <<= 1)
+    {
+        uint32_t step = powMod(root, (p - 1) / length, p);
+        if (inverse)
+            step = invMod(step, p);
+        for (size_t start = 0; start < n; start += length)
+        {
+            uint32_t w = 1;
+            for (size_t k = 0; k < length / 2; k++)
+            {
+                uint32_t u = a[start + k];
+                uint32_t v = mulMod(a[start + k + length / 2], w, p);
+                a[start + k] = addMod(u, v, p);
+                a[start + k + length / 2] = subMod(u, v, p);
+                w = mulMod(w, step, p);
+            }
+        }
+    }
+
+    if (inverse)
+    {
+        uint32_t scale = invMod(n % p, p);
+        for (uint32_t &x : a)
+            x = mulMod(x, scale, p);
+    }
+}
+}
+
+vector<uint32_t> convolveMod(const vector<uint32_t> &a, const vector<uint32_t> &b, uint32_t p)
+{
+    if (a.empty() || b.empty())
+        return vector<uint32_t>();
+
+    size_t resultSize = a.size() + b.size() - 1;
+    size_t n = 1;
+    while (n < resultSize)
+        n <<= 1;
+    if ((p - 1) % n != 0)
+        throw invalid_argument("convolveMod: p - 1 is not divisible by the transform size");
+
+    uint32_t root = primitiveRoot(p);
+    vector<uint32_t> fa(a.begin(), a.end()), fb(b.begin(), b.end());
+    fa.resize(n, 0);
+    fb.resize(n, 0);
+    ntt(fa, false, p, root);
+    ntt(fb, false, p, root);
+    for (size_t i = 0; i < n; i++)
+        fa[i] = mulMod(fa[i], fb[i], p);
+    ntt(fa, true, p, root);
+    fa.resize(resultSize);
+    return fa;
+}
@@ -0,0 +1,21 @@
+/*
+ * Ntt.h
+ */
+
+#ifndef NTT_H_
+#define NTT_H_
+
+#include "Defs.h"
+#include <cstdint>
+#include <vector>
+
+/* Primo usado por omissao: 998244353 = 119 * 2^23 + 1 */
+const uint32_t NTT_PRIME = 998244353;
+
+/* Convolucao (produto de polinomios) modulo p pela transformada numerica
+ * (NTT), em O(n log n). p tem de ser primo da forma c * 2^k + 1 com 2^k >= a
+ * dimensao do resultado; caso contrario lanca invalid_argument.
+ * */
+vector<uint32_t> convolveMod(const vector<uint32_t> &a, const vector<uint32_t> &b, uint32_t p = NTT_PRIME);
+
+#endif /* NTT_H_ */
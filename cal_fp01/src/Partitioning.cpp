@@ -3,7 +3,8 @@
  */
 
 #include "Partitioning.h"
-#include <ctime>
+#include "Memo.h"
+#include <stdexcept>
 
 
 int s_recursive(int n,int k)
@@ -18,33 +19,105 @@ int s_dynamic(int n,int k)
 	vector<int> vec(k, 1);
 	for(int i = 0; i < (n - k); i++){
 		for(int j = 0; j < k; j++){
-			vec[j] = (j + 1) * vec[j] + vec[j - 1];
+			vec[j] = (j + 1) * vec[j] + (j > 0 ? vec[j - 1] : 0);
 		}
 	}
 	return vec[k - 1];
 }
 
+namespace
+{
+MemoTable<int> stirlingMemo;
+}
+
+int s_memoized(int n,int k)
+{
+    if(k == 1 || n == k)
+        return 1;
+    return memoize(stirlingMemo, n, k, [n, k]() {
+        return s_memoized(n - 1, k - 1) + k * s_memoized(n - 1, k);
+    });
+}
+
+int b_memoized(int n)
+{
+    int b = 0;
+    for(int i = 1; i <= n; i++)
+        b += s_memoized(n, i);
+    return b;
+}
 
 int b_recursive(int n)
 {
-    clock_t time = clock();
 	int b = 0;
 	for(int i = 1; i <= n; i++){
 		b+=s_recursive(n, i);
 	}
-    cout << (clock() - time) << endl;
     return b;
 }
 
 int b_dynamic(int n)
 {
-    clock_t time = clock();
     int b = 0;
 	for(int i = 1; i <= n; i++){
 		b+=s_dynamic(n, i);
 	}
-    cout << (clock() - time) << endl;
     return b;
 }
 
 
+
+namespace
+{
+StirlingTable<BigIntRing> &sharedStirlingTable()
+{
+    static StirlingTable<BigIntRing> table;
+    return table;
+}
+
+PartitionTable<BigIntRing> &sharedPartitionTable()
+{
+    static PartitionTable<BigIntRing> table;
+    return table;
+}
+}
+
+BigInt s_exact(int n, int k)
+{
+    return sharedStirlingTable().s(n, k);
+}
+
+BigInt b_exact(int n)
+{
+    return sharedStirlingTable().b(n);
+}
+
+BigInt p_exact(int n)
+{
+    return sharedPartitionTable().p(n);
+}
+
+vector<uint32_t> stirlingRowMod(int n, uint32_t p)
+{
+    if (n < 0 || (uint32_t) n >= p)
+        throw invalid_argument("stirlingRowMod: n must be in [0, p)");
+
+    vector<uint32_t> invFactorial(n + 1);
+    uint32_t factorial = 1;
+    for (int i = 1; i <= n; i++)
+        factorial = mulMod(factorial, i, p);
+    invFactorial[n] = invMod(factorial, p);
+    for (int i = n; i > 0; i--)
+        invFactorial[i - 1] = mulMod(invFactorial[i], i, p);
+
+    vector<uint32_t> powers(n + 1), signs(n + 1);
+    for (int i = 0; i <= n; i++)
+    {
+        powers[i] = mulMod(powMod(i, n, p), invFactorial[i], p);
+        signs[i] = i % 2 == 0 ? invFactorial[i] : subMod(0, invFactorial[i], p);
+    }
+
+    vector<uint32_t> row = convolveMod(powers, signs, p);
+    row.resize(n + 1);
+    return row;
+}
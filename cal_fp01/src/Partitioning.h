@@ -6,6 +6,12 @@
 #define PARTITIONING_H_
 
 #include "Defs.h"
+#include "BigInt.h"
+#include "ModArith.h"
+#include "Ntt.h"
+#include <mutex>
+#include <stdexcept>
+#include <vector>
 
 /*Implementa a funo s(n,k) usando recursividade*/
 int s_recursive(int n,int k);
@@ -19,4 +25,164 @@ int s_dynamic(int n,int k);
 /*Implementa a funo b(n) usando programao dinmica*/
 int b_dynamic(int n);
 
+/*Implementa a funcao s(n,k) usando recursividade com memorizacao (MemoTable partilhada)*/
+int s_memoized(int n,int k);
+
+/*Implementa a funcao b(n) usando recursividade com memorizacao*/
+int b_memoized(int n);
+
+/* Triangulo dos numeros de Stirling de segunda especie, calculado uma so vez
+ * e estendido linha a linha quando se pede um n maior.
+ * Os numeros de Bell vem do triangulo de Bell, em O(n^2) adicoes no total.
+ * Ring define a aritmetica: BigIntRing (valores exatos) ou ModRing (modulo p).
+ * Pode ser partilhado entre threads.
+ * */
+template <class Ring>
+class StirlingTable
+{
+public:
+    typedef typename Ring::value_type value_type;
+
+private:
+    Ring ring;
+    vector<vector<value_type> > rows;
+    vector<value_type> bellRow;
+    vector<value_type> bells;
+    mutex tableMutex;
+
+    void extendRows(int n)
+    {
+        while ((int) rows.size() <= n)
+        {
+            const vector<value_type> &previous = rows.back();
+            int i = rows.size();
+            vector<value_type> row(i + 1, ring.zero());
+            for (int k = 1; k <= i; k++)
+            {
+                if (k < i)
+                    row[k] = ring.mulSmall(previous[k], k);
+                ring.add(row[k], previous[k - 1]);
+            }
+            rows.push_back(move(row));
+        }
+    }
+
+    void extendBells(int n)
+    {
+        while ((int) bells.size() <= n)
+        {
+            vector<value_type> next(bellRow.size() + 1);
+            next[0] = bellRow.back();
+            for (size_t j = 1; j < next.size(); j++)
+            {
+                next[j] = next[j - 1];
+                ring.add(next[j], bellRow[j - 1]);
+            }
+            bellRow.swap(next);
+            bells.push_back(bellRow[0]);
+        }
+    }
+
+public:
+    StirlingTable(Ring ring = Ring()) : ring(ring)
+    {
+        rows.push_back(vector<value_type>(1, ring.one()));
+        bellRow.push_back(ring.one());
+        bells.push_back(ring.one());
+    }
+
+    /* s(n,k), com n >= 0; zero se k < 0 ou k > n */
+    value_type s(int n, int k)
+    {
+        if (n < 0)
+            throw invalid_argument("StirlingTable: n must be non-negative");
+        if (k < 0 || k > n)
+            return ring.zero();
+        lock_guard<mutex> lock(tableMutex);
+        extendRows(n);
+        return rows[n][k];
+    }
+
+    /* b(n), com n >= 0 */
+    value_type b(int n)
+    {
+        if (n < 0)
+            throw invalid_argument("StirlingTable: n must be non-negative");
+        lock_guard<mutex> lock(tableMutex);
+        extendBells(n);
+        return bells[n];
+    }
+};
+
+/* s(n,k) exato, usando uma StirlingTable partilhada */
+BigInt s_exact(int n, int k);
+
+/* b(n) exato, usando uma StirlingTable partilhada */
+BigInt b_exact(int n);
+
+/* Numero de particoes inteiras p(n), pela recorrencia dos numeros pentagonais
+ * de Euler: p(n) = sum_k (-1)^(k+1) [p(n - k(3k-1)/2) + p(n - k(3k+1)/2)].
+ * Cada valor custa O(sqrt n) somas, O(n sqrt n) para a tabela toda.
+ * Os valores ficam guardados e a tabela e estendida quando se pede um n maior.
+ * Ring precisa de sub(); as parcelas positivas e negativas sao somadas em
+ * separado, para que BigIntRing nunca passe por valores negativos.
+ * Pode ser partilhado entre threads.
+ * */
+template <class Ring>
+class PartitionTable
+{
+public:
+    typedef typename Ring::value_type value_type;
+
+private:
+    Ring ring;
+    vector<value_type> values;
+    mutex tableMutex;
+
+    void extend(int n)
+    {
+        values.reserve(n + 1);
+        while ((int) values.size() <= n)
+        {
+            long long i = values.size();
+            value_type plus = ring.zero();
+            value_type minus = ring.zero();
+            for (long long k = 1; k * (3 * k - 1) / 2 <= i; k++)
+            {
+                value_type &target = (k % 2 == 1) ? plus : minus;
+                ring.add(target, values[i - k * (3 * k - 1) / 2]);
+                if (k * (3 * k + 1) / 2 <= i)
+                    ring.add(target, values[i - k * (3 * k + 1) / 2]);
+            }
+            ring.sub(plus, minus);
+            values.push_back(move(plus));
+        }
+    }
+
+public:
+    PartitionTable(Ring ring = Ring()) : ring(ring)
+    {
+        values.push_back(ring.one());
+    }
+
+    /* p(n), com n >= 0 */
+    value_type p(int n)
+    {
+        if (n < 0)
+            throw invalid_argument("PartitionTable: n must be non-negative");
+        lock_guard<mutex> lock(tableMutex);
+        extend(n);
+        return values[n];
+    }
+};
+
+/* p(n) exato, usando uma PartitionTable partilhada */
+BigInt p_exact(int n);
+
+/* Linha completa s(n,0..n) modulo p, em O(n log n), pela formula explicita
+ * s(n,k) = sum_i (-1)^(k-i) i^n / (i! (k-i)!) calculada como uma convolucao (NTT).
+ * p tem de ser um primo adequado a NTT (ver convolveMod) e maior que n.
+ * */
+vector<uint32_t> stirlingRowMod(int n, uint32_t p = NTT_PRIME);
+
 #endif /* SUM_H_ */
@@ -3,43 +3,149 @@
  */
 
 #include "Sum.h"
-#include <chrono>
+#include "Cpu.h"
+#include <algorithm>
+#include <thread>
 
-string calcSum(int* sequence, int size)
+namespace
+{
+long long minWindowSumScalar(const long long *prefix, int count, int length)
+{
+    long long best = prefix[length] - prefix[0];
+    for (int i = 1; i < count; i++)
+        best = min(best, prefix[i + length] - prefix[i]);
+    return best;
+}
+
+#ifdef HAVE_X86_SIMD
+__attribute__((target("avx2")))
+long long minWindowSumAvx2(const long long *prefix, int count, int length)
 {
+    if (count < 8)
+        return minWindowSumScalar(prefix, count, length);
 
-    int minSum;
-    std::pair<int, int> mininums[size];
-    int index;
-    for(int i = 1; i <= size; i++)
+    __m256i best = _mm256_sub_epi64(_mm256_loadu_si256((const __m256i *) (prefix + length)),
+            _mm256_loadu_si256((const __m256i *) prefix));
+    int i = 4;
+    for (; i + 4 <= count; i += 4)
     {
-        minSum = 0;
-        for(int j = 0; j < i; j++)
-            minSum += sequence[j];
+        __m256i sums = _mm256_sub_epi64(_mm256_loadu_si256((const __m256i *) (prefix + i + length)),
+                _mm256_loadu_si256((const __m256i *) (prefix + i)));
+        best = _mm256_blendv_epi8(best, sums, _mm256_cmpgt_epi64(best, sums));
+    }
 
-        index = 0;
-        for(int j = 1; j < size - i + 1; j++)
-        {
-            int sum = 0;
-            for(int k = j; k <= j + i - 1; k++)
-            {
-                sum += sequence[k];
-            }
-            if(sum < minSum)
-            {
-                minSum = sum;
-                index = j;
-            }
+    long long lanes[4];
+    _mm256_storeu_si256((__m256i *) lanes, best);
+    long long result = min(min(lanes[0], lanes[1]), min(lanes[2], lanes[3]));
+    for (; i < count; i++)
+        result = min(result, prefix[i + length] - prefix[i]);
+    return result;
+}
+#endif
 
-        }
-        mininums[i - 1] = make_pair(minSum, index);
-    }
+/* Minimum sum of the windows with the given length, and its first index */
+pair<long long, int> minWindow(const long long *prefix, int size, int length)
+{
+    int count = size - length + 1;
+#ifdef HAVE_X86_SIMD
+    long long best = cpuHasAvx2() ? minWindowSumAvx2(prefix, count, length)
+            : minWindowSumScalar(prefix, count, length);
+#else
+    long long best = minWindowSumScalar(prefix, count, length);
+#endif
+    int index = 0;
+    while (prefix[index + length] - prefix[index] != best)
+        index++;
+    return make_pair(best, index);
+}
+}
+
+vector<pair<long long, int> > calcMinSums(const int* sequence, int size, unsigned numThreads)
+{
+    vector<pair<long long, int> > result(size);
+    calcMinSums(sequence, size, result.data(), numThreads);
+    return result;
+}
+
+void calcMinSums(const int* sequence, int size, pair<long long, int>* result, unsigned numThreads)
+{
+    vector<long long> prefix(size + 1, 0);
+    for (int i = 0; i < size; i++)
+        prefix[i + 1] = prefix[i] + sequence[i];
+
+    auto work = [&](unsigned first, unsigned step) {
+        // Interleaved lengths keep the per-thread work balanced.
+        for (int length = first + 1; length <= size; length += step)
+            result[length - 1] = minWindow(prefix.data(), size, length);
+    };
+
+    numThreads = max(1u, min<unsigned>(numThreads, size));
+    vector<thread> workers;
+    for (unsigned t = 1; t < numThreads; t++)
+        workers.emplace_back(work, t, numThreads);
+    work(0, numThreads);
+    for (thread &worker : workers)
+        worker.join();
+}
 
+string formatSums(const pair<long long, int>* sums, int size)
+{
+    // Appending piece by piece keeps each temporary within the small-string
+    // buffer, so only the result itself touches the heap.
     string result;
-    for(int i = 0; i < size; i++)
+    result.reserve(size * 8);
+    for (int i = 0; i < size; i++)
+    {
+        result += to_string(sums[i].first);
+        result += ',';
+        result += to_string(sums[i].second);
+        result += ';';
+    }
+    return result;
+}
+
+string calcSum(int* sequence, int size)
+{
+    vector<pair<long long, int> > sums = calcMinSums(sequence, size);
+    return formatSums(sums.data(), size);
+}
+
+StreamingMinSum::StreamingMinSum(const vector<int>& windows)
+    : windows(windows), sums(windows.size(), 0),
+      minimums(windows.size(), make_pair(0LL, -1LL)), count(0)
+{
+    int longest = 1;
+    for (int length : windows)
+        longest = max(longest, length);
+    recent.assign(longest, 0);
+}
+
+void StreamingMinSum::push(int value)
+{
+    size_t capacity = recent.size();
+    for (size_t w = 0; w < windows.size(); w++)
     {
-        result+=to_string(mininums[i].first) + "," + to_string(mininums[i].second) + ";";
+        int length = windows[w];
+        sums[w] += value;
+        if (count >= length)
+            sums[w] -= recent[(count - length) % capacity];
+        if (count + 1 >= length)
+        {
+            long long start = count + 1 - length;
+            if (minimums[w].second < 0 || sums[w] < minimums[w].first)
+                minimums[w] = make_pair(sums[w], start);
+        }
     }
-	return result;
+    recent[count % capacity] = value;
+    count++;
 }
 
+long long StreamingMinSum::size() const
+{
+    return count;
+}
+
+pair<long long, long long> StreamingMinSum::getMinimum(size_t w) const
+{
+    return minimums[w];
+}
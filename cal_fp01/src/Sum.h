@@ -6,6 +6,8 @@
 #define SUM_H_
 
 #include "Defs.h"
+#include <utility>
+#include <vector>
 
 /* Calcula, numa sequncia de n nmeros (n > 0), para cada subsequncia de m nmeros (m <= n, m > 0),
  * o ndice i a partir do qual a soma s dos valores dessa subsequncia  mnimo.
@@ -21,4 +23,48 @@
  */
 string calcSum(int* sequence, int size);
 
+/* Mesmo calculo que calcSum, devolvido de forma estruturada:
+ * result[m - 1] = (soma minima, indice) para as subsequencias de m numeros.
+ * Em caso de empate fica o menor indice.
+ * Usa somas prefixas (O(size^2)) e, para cada m, uma reducao SIMD do minimo.
+ * Com numThreads > 1 os comprimentos m sao repartidos por varias threads.
+ * */
+vector<pair<long long, int> > calcMinSums(const int* sequence, int size, unsigned numThreads = 1);
+
+/* Igual a calcMinSums, mas escreve em result (array com size posicoes,
+ * fornecido por quem chama) */
+void calcMinSums(const int* sequence, int size, pair<long long, int>* result, unsigned numThreads = 1);
+
+/* Formata os resultados de calcMinSums como calcSum: "1,4;9,1;11,2;" */
+string formatSums(const pair<long long, int>* sums, int size);
+
+/* Versao em fluxo de calcSum para um conjunto fixo de comprimentos de janela.
+ * Os numeros chegam um a um (push) e nunca e guardada a sequencia inteira:
+ * a memoria e O(maior janela) e cada numero custa O(1) por janela.
+ * */
+class StreamingMinSum
+{
+    vector<int> windows;
+    vector<int> recent;
+    vector<long long> sums;
+    vector<pair<long long, long long> > minimums;
+    long long count;
+
+public:
+    /* windows - comprimentos das janelas (> 0) */
+    StreamingMinSum(const vector<int>& windows);
+
+    /* Acrescenta o proximo numero da sequencia */
+    void push(int value);
+
+    /* Quantidade de numeros recebidos ate agora */
+    long long size() const;
+
+    /* Para a janela windows[w], devolve (soma minima, indice de inicio) ate agora,
+     * com o menor indice em caso de empate; o indice e -1 enquanto houver menos
+     * de windows[w] numeros.
+     * */
+    pair<long long, long long> getMinimum(size_t w) const;
+};
+
 #endif /* SUM_H_ */
@@ -1,13 +1,18 @@
 #include "Defs.h"
 #include "Factorial.h"
 #include "Change.h"
+#include "ChangeKernel.h"
 #include "Sum.h"
 #include "Partitioning.h"
+#include "ConstTables.h"
+#include "Memo.h"
+#include "Binomial.h"
 
 #include "cute/cute.h"
 #include "cute/ide_listener.h"
 #include "cute/xml_listener.h"
 #include "cute/cute_runner.h"
+#include <thread>
 
 void factorialTest()
 {
@@ -17,6 +22,40 @@ void factorialTest()
         ASSERT_EQUAL(3628800,factorialDinam(10));
 }
 
+void factorialBigTest()
+{
+	clearFactorialCache();
+	ASSERT_EQUAL("1",factorialBig(0).toString());
+	ASSERT_EQUAL("1",factorialBig(1).toString());
+	ASSERT_EQUAL(to_string(factorialDinam(10)),factorialBig(10).toString());
+	ASSERT_EQUAL("2432902008176640000",factorialBig(20).toString());
+	ASSERT_EQUAL("15511210043330985984000000",factorialBig(25).toString());
+	ASSERT_EQUAL("30414093201713378043612608166064768844377641568960512000000000000",factorialBig(50).toString());
+
+	BigInt naive(1);
+	for(int i = 2; i <= 3000; i++)
+		naive *= i;
+	clearFactorialCache();
+	ASSERT(naive == factorialBig(3000, 4));
+	ASSERT(naive == factorialBig(3000));
+	clearFactorialCache();
+
+	// A sweep reuses the previous values, but the cache keeps only the last 16.
+	BigInt fact(1);
+	for(int n = 1; n <= 40; n++)
+	{
+		fact *= n;
+		ASSERT(fact == factorialBig(n));
+	}
+	ASSERT_EQUAL(16u, factorialCacheSize());
+	ASSERT_EQUAL("30414093201713378043612608166064768844377641568960512000000000000",factorialBig(50).toString());
+	ASSERT_EQUAL("15511210043330985984000000",factorialBig(25).toString());
+	ASSERT_EQUAL(16u, factorialCacheSize());
+	clearFactorialCache();
+	ASSERT_EQUAL(0u, factorialCacheSize());
+	ASSERT(naive == productRange(1, 3000));
+}
+
 void calcChangeTest()
 {
 	int numCoins = 3;
@@ -38,6 +77,228 @@ void calcChangeTest()
 
 }
 
+void calcChangeCountsTest()
+{
+	int coinValues[] = {1, 2, 5};
+	int counts[3];
+	ASSERT(calcChangeCounts(16, 3, coinValues, counts));
+	ASSERT_EQUAL(1, counts[0]);
+	ASSERT_EQUAL(0, counts[1]);
+	ASSERT_EQUAL(3, counts[2]);
+	ASSERT_EQUAL("5;5;5;1;",formatChange(3, coinValues, counts));
+
+	int coinValues2[] = {2, 5};
+	ASSERT(!calcChangeCounts(3, 2, coinValues2, counts));
+	ASSERT(calcChangeCounts(0, 2, coinValues2, counts));
+	ASSERT_EQUAL("",formatChange(2, coinValues2, counts));
+
+	int coinValues3[] = {1, 4, 5};
+	CoinSystem coins(3, coinValues3);
+	ASSERT(coins.calcChangeCounts(8, counts));
+	ASSERT_EQUAL(2, counts[1]);
+	ASSERT_EQUAL(coins.calcChange(13), "5;4;4;");
+}
+
+void calcChangeBoundedTest()
+{
+	int coinValues[] = {1, 2, 5};
+	int coinCounts[] = {3, 1, 2};
+	ASSERT_EQUAL("5;5;2;",calcChangeBounded(12, 3, coinValues, coinCounts));
+	ASSERT_EQUAL("5;5;2;1;1;1;",calcChangeBounded(15, 3, coinValues, coinCounts));
+	ASSERT_EQUAL("-",calcChangeBounded(16, 3, coinValues, coinCounts));
+	ASSERT_EQUAL("",calcChangeBounded(0, 3, coinValues, coinCounts));
+
+	int many[] = {100, 100, 100};
+	ASSERT_EQUAL(calcChange(97, 3, coinValues),calcChangeBounded(97, 3, coinValues, many));
+
+	// Compare the number of coins with an exhaustive search.
+	srand(5);
+	for(int trial = 0; trial < 200; trial++)
+	{
+		int values[3], counts[3];
+		values[0] = 1 + rand() % 4;
+		values[1] = values[0] + 1 + rand() % 5;
+		values[2] = values[1] + 1 + rand() % 7;
+		for(int i = 0; i < 3; i++)
+			counts[i] = rand() % 4;
+		int m = rand() % 40;
+
+		int optimal = -1;
+		for(int a = 0; a <= counts[0]; a++)
+			for(int b = 0; b <= counts[1]; b++)
+				for(int c = 0; c <= counts[2]; c++)
+					if(a * values[0] + b * values[1] + c * values[2] == m && (optimal < 0 || a + b + c < optimal))
+						optimal = a + b + c;
+
+		string change = calcChangeBounded(m, 3, values, counts);
+		if(optimal < 0)
+		{
+			ASSERT_EQUAL("-", change);
+			continue;
+		}
+		int total = 0, coins = 0, used[3] = {0, 0, 0};
+		for(size_t pos = 0; pos < change.size(); pos = change.find(';', pos) + 1)
+		{
+			int value = stoi(change.substr(pos));
+			total += value;
+			coins++;
+			for(int i = 0; i < 3; i++)
+				if(values[i] == value)
+					used[i]++;
+		}
+		ASSERT_EQUAL(m, total);
+		ASSERT_EQUAL(optimal, coins);
+		for(int i = 0; i < 3; i++)
+			ASSERT(used[i] <= counts[i]);
+	}
+}
+
+void coinSystemTest()
+{
+	int coinValues[] = {1, 3, 4};
+	CoinSystem coins(3, coinValues, 10);
+	ASSERT_EQUAL(10, coins.getMaxAmount());
+	ASSERT_EQUAL("4;4;4;3;3;",coins.calcChange(18));
+	ASSERT_EQUAL(20, coins.getMaxAmount());
+	ASSERT_EQUAL("3;3;",coins.calcChange(6));
+	ASSERT_EQUAL("",coins.calcChange(0));
+	ASSERT_EQUAL(5, coins.countCoins(18));
+
+	int coinValues2[] = {2, 5};
+	CoinSystem coins2(2, coinValues2);
+	ASSERT_EQUAL("-",coins2.calcChange(1));
+	ASSERT_EQUAL("-",coins2.calcChange(3));
+	ASSERT_EQUAL(-1, coins2.countCoins(3));
+	ASSERT_EQUAL("5;2;",coins2.calcChange(7));
+
+	int coinValues3[] = {1, 4, 5};
+	CoinSystem coins3(3, coinValues3);
+	vector<thread> workers;
+	vector<string> results(4);
+	for(int t = 0; t < 4; t++)
+		workers.emplace_back([&coins3, &results, t]() { results[t] = coins3.calcChange(8 + 1000 * t); });
+	for(thread &worker : workers)
+		worker.join();
+	ASSERT_EQUAL("4;4;",results[0]);
+	for(int t = 0; t < 4; t++)
+		ASSERT_EQUAL(coins3.calcChange(8 + 1000 * t), results[t]);
+	ASSERT(coins3.getMaxAmount() >= 3008);
+}
+
+void canonicalCoinsTest()
+{
+	int euro[] = {1, 2, 5, 10, 20, 50, 100, 200};
+	int us[] = {1, 5, 10, 25};
+	int coinValues[] = {1, 3, 4};
+	int coinValues2[] = {2, 5};
+	ASSERT(isCanonical(8, euro));
+	ASSERT(isCanonical(4, us));
+	ASSERT(!isCanonical(3, coinValues));
+	ASSERT(!isCanonical(2, coinValues2));
+
+	ChangeStrategy strategy;
+	ASSERT_EQUAL("200;100;20;20;5;2;1;",calcChange(348, 8, euro, &strategy));
+	ASSERT_EQUAL(GREEDY_CHANGE, strategy);
+	ASSERT_EQUAL("3;3;",calcChange(6, 3, coinValues, &strategy));
+	ASSERT_EQUAL(DYNAMIC_CHANGE, strategy);
+	ASSERT_EQUAL(GREEDY_CHANGE, CoinSystem(4, us).getStrategy());
+	ASSERT_EQUAL(0, CoinSystem(4, us, 1000).getMaxAmount());
+
+	// Compare with a brute-force check for every system {1, a, b, c}.
+	// Counterexamples, if any, are smaller than the sum of the two largest coins.
+	for(int a = 2; a <= 12; a++)
+		for(int b = a + 1; b <= 13; b++)
+			for(int c = b + 1; c <= 14; c++)
+			{
+				int system[] = {1, a, b, c};
+				vector<int> optimal(b + c, 0);
+				bool canonical = true;
+				for(int x = 1; x < b + c; x++)
+				{
+					optimal[x] = optimal[x - 1] + 1;
+					for(int coin : {a, b, c})
+						if(coin <= x)
+							optimal[x] = min(optimal[x], optimal[x - coin] + 1);
+					int greedy = x / c + x % c / b + x % c % b / a + x % c % b % a;
+					canonical = canonical && greedy == optimal[x];
+				}
+				ASSERT_EQUAL(canonical, isCanonical(4, system));
+			}
+}
+
+
+void largeAmountChangeTest()
+{
+	int coinValues[] = {1, 3, 4};
+	int coinValues2[] = {2, 5};
+	int coinValues3[] = {4, 6, 9};
+	for(int *system : {coinValues, coinValues2, coinValues3})
+	{
+		int numCoins = system == coinValues2 ? 2 : 3;
+		CoinSystem coins(numCoins, system);
+		CoinSystem small(numCoins, system, 300);
+		for(int m = 0; m <= 300; m++)
+		{
+			ChangeHistogram change = coins.calcChangeHistogram(m);
+			ASSERT_EQUAL(small.countCoins(m) >= 0, change.possible);
+			if(!change.possible)
+				continue;
+			long long value = 0, count = 0;
+			for(int i = 0; i < numCoins; i++)
+			{
+				value += change.counts[i] * system[i];
+				count += change.counts[i];
+			}
+			ASSERT_EQUAL(m, value);
+			ASSERT_EQUAL(small.countCoins(m), count);
+		}
+		ASSERT(coins.getMaxAmount() <= 2 * coins.getLargeAmountThreshold());
+	}
+
+	CoinSystem coins(3, coinValues);
+	ChangeHistogram change = coins.calcChangeHistogram(1000000000000000001ULL);
+	ASSERT(change.possible);
+	ASSERT_EQUAL(1000000000000000001ULL, change.counts[0] + 3 * change.counts[1] + 4 * change.counts[2]);
+	ASSERT_EQUAL(250000000000000001ULL, change.counts[0] + change.counts[1] + change.counts[2]);
+	ASSERT(coins.getMaxAmount() <= 24);
+
+	CoinSystem coins2(2, coinValues2);
+	ASSERT(coins2.calcChangeHistogram(3000000000ULL).possible);
+	ASSERT_EQUAL(600000000ULL, coins2.calcChangeHistogram(3000000000ULL).counts[1]);
+	ASSERT(!coins2.calcChangeHistogram(3).possible);
+
+	// Threshold 99999 * 100000 > INT_MAX: small remainders still work, larger ones are rejected.
+	int largeValues[] = { 1, 99999, 100000 };
+	CoinSystem large(3, largeValues);
+	ASSERT_EQUAL(DYNAMIC_CHANGE, large.getStrategy());
+	ASSERT_EQUAL(9999900000LL, large.getLargeAmountThreshold());
+	ASSERT_EQUAL(2ULL, large.calcChangeHistogram(199998).counts[1]);
+	ASSERT_THROWS(large.calcChangeHistogram(3000000000ULL), invalid_argument);
+	ASSERT_THROWS(large.calcChangeHistogram(1000000000000000000ULL), invalid_argument);
+}
+
+void changeKernelTest()
+{
+	const int m = 5000;
+	const int INF = 1 << 20;
+	srand(7);
+	for(int trial = 0; trial < 20; trial++)
+	{
+		vector<int> minScalar(m + 1, INF), lastScalar(m + 1, 0);
+		minScalar[0] = 0;
+		vector<int> minFast(minScalar), lastFast(lastScalar);
+		int coin = 1 + trial % 3;
+		for(int i = 0; i < 6; i++)
+		{
+			relaxCoinScalar(minScalar.data(), lastScalar.data(), m, coin, i);
+			relaxCoin(minFast.data(), lastFast.data(), m, coin, i);
+			coin += 1 + rand() % 9;
+		}
+		ASSERT(minScalar == minFast);
+		ASSERT(lastScalar == lastFast);
+	}
+	ASSERT_EQUAL(string("scalar"), string(relaxCoinPath(3)));
+}
 
 void calcSumArrayTest()
 {
@@ -48,6 +309,98 @@ void calcSumArrayTest()
 	ASSERT_EQUAL("1,1;5,3;11,3;16,1;20,3;24,3;31,1;35,1;41,0;",calcSum(sequence2, 9));
 }
 
+void calcMinSumsTest()
+{
+	int sequence[9] = {6,1,10,3,2,6,7,2,4};
+	vector<pair<long long, int> > sums = calcMinSums(sequence, 9);
+	ASSERT_EQUAL(9u, sums.size());
+	ASSERT_EQUAL(5LL, sums[1].first);
+	ASSERT_EQUAL(3, sums[1].second);
+
+	// Compare with the direct O(n^3) definition, with and without threads.
+	const int size = 300;
+	vector<int> random(size);
+	srand(3);
+	for(int &value : random)
+		value = rand() % 2001 - 1000;
+	vector<pair<long long, int> > single = calcMinSums(random.data(), size);
+	ASSERT(single == calcMinSums(random.data(), size, 4));
+	for(int length = 1; length <= size; length++)
+	{
+		long long best = 0;
+		int index = -1;
+		for(int i = 0; i + length <= size; i++)
+		{
+			long long sum = 0;
+			for(int k = i; k < i + length; k++)
+				sum += random[k];
+			if(index < 0 || sum < best)
+			{
+				best = sum;
+				index = i;
+			}
+		}
+		ASSERT_EQUAL(best, single[length - 1].first);
+		ASSERT_EQUAL(index, single[length - 1].second);
+	}
+}
+
+void formatSumsTest()
+{
+	int sequence[5] = {4,7,2,8,1};
+	pair<long long, int> sums[5];
+	calcMinSums(sequence, 5, sums);
+	ASSERT_EQUAL("1,4;9,1;11,2;18,1;22,0;",formatSums(sums, 5));
+	ASSERT_EQUAL(18LL, sums[3].first);
+	ASSERT_EQUAL(1, sums[3].second);
+	ASSERT_EQUAL("",formatSums(sums, 0));
+}
+
+void streamingMinSumTest()
+{
+	int sequence[9] = {6,1,10,3,2,6,7,2,4};
+	vector<int> windows;
+	for(int length = 1; length <= 9; length++)
+		windows.push_back(length);
+	StreamingMinSum stream(windows);
+	for(int i = 0; i < 9; i++)
+	{
+		ASSERT_EQUAL(-1LL, stream.getMinimum(i).second);
+		stream.push(sequence[i]);
+	}
+	ASSERT_EQUAL(9LL, stream.size());
+
+	vector<pair<long long, int> > expected = calcMinSums(sequence, 9);
+	for(int length = 1; length <= 9; length++)
+	{
+		ASSERT_EQUAL(expected[length - 1].first, stream.getMinimum(length - 1).first);
+		ASSERT_EQUAL(expected[length - 1].second, stream.getMinimum(length - 1).second);
+	}
+
+	vector<int> windows2 = {7, 50, 3};
+	StreamingMinSum stream2(windows2);
+	vector<long long> prefix(1, 0);
+	srand(11);
+	for(int i = 0; i < 10000; i++)
+	{
+		int value = rand() % 201 - 100;
+		stream2.push(value);
+		prefix.push_back(prefix.back() + value);
+	}
+	for(size_t w = 0; w < windows2.size(); w++)
+	{
+		long long best = 0, index = -1;
+		for(long long i = 0; i + windows2[w] < (long long) prefix.size(); i++)
+			if(index < 0 || prefix[i + windows2[w]] - prefix[i] < best)
+			{
+				best = prefix[i + windows2[w]] - prefix[i];
+				index = i;
+			}
+		ASSERT_EQUAL(best, stream2.getMinimum(w).first);
+		ASSERT_EQUAL(index, stream2.getMinimum(w).second);
+	}
+}
+
 void partitioningTest()
 {
 	ASSERT_EQUAL(3025,s_recursive(9,3));
@@ -62,13 +415,223 @@ void partitioningTest()
 	ASSERT_EQUAL(1382958545,b_dynamic(15));
 }
 
+void stirlingTableTest()
+{
+	ASSERT_EQUAL("3025",s_exact(9,3).toString());
+	ASSERT_EQUAL("22827",s_exact(10,6).toString());
+	ASSERT_EQUAL("1",s_exact(0,0).toString());
+	ASSERT_EQUAL("0",s_exact(5,0).toString());
+	ASSERT_EQUAL("0",s_exact(3,5).toString());
+	ASSERT_EQUAL("0",s_exact(3,-1).toString());
+	ASSERT_THROWS(s_exact(-1,0), invalid_argument);
+	ASSERT_THROWS(b_exact(-1), invalid_argument);
+	ASSERT_EQUAL("1",b_exact(0).toString());
+	ASSERT_EQUAL("203",b_exact(6).toString());
+	ASSERT_EQUAL("1382958545",b_exact(15).toString());
+	ASSERT_EQUAL("47585391276764833658790768841387207826363669686825611466616334637559114497892442622672724044217756306953557882560751",b_exact(100).toString());
+
+	// The Bell triangle and the row sums of the Stirling triangle must agree.
+	BigInt sum(0);
+	for(int k = 0; k <= 60; k++)
+		sum += s_exact(60, k);
+	ASSERT(sum == b_exact(60));
+
+	const uint32_t p = 1000000007;
+	StirlingTable<ModRing> table{ModRing(p)};
+	for(int n : {30, 200, 700})
+	{
+		BigInt exact = b_exact(n);
+		ASSERT_EQUAL(exact.divideSmall(p), table.b(n));
+		BigInt stirling = s_exact(n, n / 3);
+		ASSERT_EQUAL(stirling.divideSmall(p), table.s(n, n / 3));
+	}
+}
+
+void stirlingRowModTest()
+{
+	vector<uint32_t> row = stirlingRowMod(10);
+	ASSERT_EQUAL(11u, row.size());
+	ASSERT_EQUAL(0u, row[0]);
+	ASSERT_EQUAL(1u, row[1]);
+	ASSERT_EQUAL(22827u, row[6]);
+	ASSERT_EQUAL(1u, row[10]);
+	ASSERT_EQUAL(1u, stirlingRowMod(0)[0]);
+
+	StirlingTable<ModRing> table{ModRing(NTT_PRIME)};
+	vector<uint32_t> row2 = stirlingRowMod(500);
+	for(int k = 0; k <= 500; k++)
+		ASSERT_EQUAL(table.s(500, k), row2[k]);
+
+	// 7340033 = 7 * 2^20 + 1 is another NTT prime.
+	StirlingTable<ModRing> table2{ModRing(7340033)};
+	vector<uint32_t> row3 = stirlingRowMod(300, 7340033);
+	for(int k = 0; k <= 300; k++)
+		ASSERT_EQUAL(table2.s(300, k), row3[k]);
+
+	ASSERT_THROWS(stirlingRowMod(10, 1000000007), invalid_argument);
+}
+
+void constTablesTest()
+{
+	for(int n = 2; n <= 12; n++)
+		ASSERT_EQUAL(factorialDinam(n), factorialLookup(n));
+	ASSERT_EQUAL(3628800LL, (factorialLookup<long long, 5>(10)));
+	ASSERT_EQUAL(22827LL, stirlingLookup(10, 6));
+	ASSERT_EQUAL(22827LL, (stirlingLookup<long long, 4>(10, 6)));
+	ASSERT_EQUAL(s_exact(40, 3).toString(), to_string(stirlingLookup(40, 3)));
+	ASSERT_EQUAL(0LL, stirlingLookup(3, 4));
+	ASSERT_EQUAL(1382958545, (bellLookup<int, 15>(15)));
+	ASSERT_EQUAL(1382958545LL, (bellLookup<long long, 8>(15)));
+	ASSERT_EQUAL(b_exact(25).toString(), to_string(bellLookup(25)));
+	ASSERT_EQUAL(b_exact(25).toString(), to_string(bellLookup<long long, 3>(25)));
+	ASSERT_THROWS(bellLookup(-1), invalid_argument);
+	ASSERT_THROWS(factorialLookup(-1), invalid_argument);
+}
+
+void memoizationTest()
+{
+	ASSERT_EQUAL(3628800,factorialMemoized(10));
+	ASSERT_EQUAL(1,factorialMemoized(0));
+	ASSERT_EQUAL(479001600,factorialMemoized(12));
+	ASSERT_THROWS(factorialMemoized(13), out_of_range);
+	ASSERT_THROWS(factorialMemoized(-1), out_of_range);
+	ASSERT_EQUAL(3025,s_memoized(9,3));
+	ASSERT_EQUAL(22827,s_memoized(10,6));
+	for(int n = 1; n <= 12; n++)
+		for(int k = 1; k <= n; k++)
+			ASSERT_EQUAL(s_recursive(n,k),s_memoized(n,k));
+	ASSERT_EQUAL(1382958545,b_memoized(15));
+
+	MemoTable<int> lru(2);
+	int value;
+	lru.store(3, 1, 31);
+	lru.store(4, 2, 42);
+	ASSERT(lru.lookup(3, 1, value));
+	ASSERT_EQUAL(31, value);
+	lru.store(5, 5, 55);
+	ASSERT_EQUAL(2u, lru.size());
+	ASSERT(!lru.lookup(4, 2, value));
+	ASSERT(lru.lookup(3, 1, value));
+	ASSERT(lru.lookup(5, 5, value));
+	ASSERT_EQUAL(3LL, lru.getHits());
+	ASSERT_EQUAL(1LL, lru.getMisses());
+	ASSERT_THROWS(lru.store(2, 3, 0), out_of_range);
+
+	// With a capacity, memory stays bounded no matter how large n gets.
+	MemoTable<int> bounded(2);
+	bounded.store(20000, 0, 1);
+	bounded.store(30000, 15000, 2);
+	bounded.store(40000, 40000, 3);
+	ASSERT_EQUAL(2u, bounded.storageSize());
+	ASSERT(!bounded.lookup(20000, 0, value));
+	ASSERT(bounded.lookup(40000, 40000, value));
+	ASSERT_EQUAL(3, value);
+
+	MemoTable<int> linear(0, MEMO_LINEAR);
+	linear.store(1000, 0, 7);
+	ASSERT_EQUAL(1001u, linear.storageSize());
+	ASSERT_EQUAL(7, memoize(linear, 1000, []() { return 0; }));
+	ASSERT_THROWS(linear.store(5, 1, 0), out_of_range);
+
+	MemoTable<long long> shared(50);
+	vector<thread> workers;
+	vector<char> correct(4, true);
+	for(int t = 0; t < 4; t++)
+		workers.emplace_back([&shared, &correct, t]() {
+			for(int n = 0; n < 40; n++)
+				for(int k = 0; k <= n; k++)
+					if(memoize(shared, n, k, [n, k]() { return (long long) n * 100 + k; }) != n * 100LL + k)
+						correct[t] = false;
+		});
+	for(thread &worker : workers)
+		worker.join();
+	ASSERT(correct == vector<char>(4, true));
+	ASSERT_EQUAL(50u, shared.size());
+}
+
+void binomialModPTest()
+{
+	BinomialModP small(60, 1000003);
+	vector<vector<uint32_t> > pascal(61);
+	for(int n = 0; n <= 60; n++)
+	{
+		pascal[n].assign(n + 1, 1);
+		for(int r = 1; r < n; r++)
+			pascal[n][r] = (pascal[n - 1][r - 1] + pascal[n - 1][r]) % 1000003;
+		for(int r = 0; r <= n; r++)
+			ASSERT_EQUAL(pascal[n][r], small.nCr(n, r));
+	}
+	ASSERT_EQUAL(0u, small.nCr(5, 6));
+	ASSERT_EQUAL(0u, small.nCr(5, -1));
+	ASSERT_EQUAL(60u, small.nPr(5, 3));
+	ASSERT_EQUAL(3628800u % 1000003, small.factorial(10));
+	ASSERT_EQUAL(12u, small.multinomial({2, 1, 1}));
+	ASSERT_EQUAL(1680u, small.multinomial({3, 2, 2, 1}));
+	ASSERT_THROWS(small.nCr(61, 3), out_of_range);
+	ASSERT_THROWS(BinomialModP(7, 7), invalid_argument);
+	ASSERT_THROWS(BinomialModP(-1), invalid_argument);
+	ASSERT_THROWS(BinomialModP(2000000000, 13), invalid_argument);
+
+	BinomialModP large(1000000);
+	const uint32_t p = large.getModulus();
+	for(int r : {1, 17, 499999, 500000})
+		ASSERT_EQUAL((large.nCr(999999, r - 1) + large.nCr(999999, r)) % p, large.nCr(1000000, r));
+	ASSERT_EQUAL(large.factorial(1000000), mulMod(large.factorial(999999), 1000000, p));
+
+	vector<pair<int, int> > queries = {{10, 3}, {1000000, 2}, {7, 8}};
+	vector<uint32_t> answers = large.nCr(queries);
+	ASSERT_EQUAL(3u, answers.size());
+	ASSERT_EQUAL(120u, answers[0]);
+	ASSERT_EQUAL((uint32_t) (1000000LL * 999999 / 2 % p), answers[1]);
+	ASSERT_EQUAL(0u, answers[2]);
+}
+
+void partitionTableTest()
+{
+	const unsigned long long expected[] = {1, 1, 2, 3, 5, 7, 11, 15, 22, 30, 42};
+	for(int n = 0; n <= 10; n++)
+		ASSERT_EQUAL(BigInt(expected[n]), p_exact(n));
+	ASSERT_EQUAL("190569292", p_exact(100).toString());
+	ASSERT_EQUAL("3972999029388", p_exact(200).toString());
+	ASSERT_EQUAL("24061467864032622473692149727991", p_exact(1000).toString());
+	ASSERT_THROWS(p_exact(-1), invalid_argument);
+
+	const uint32_t mod = 1000000007;
+	PartitionTable<ModRing> table{ModRing(mod)};
+	ASSERT_EQUAL(190569292u, table.p(100));
+	BigInt exact = p_exact(2000);
+	ASSERT_EQUAL(exact.divideSmall(mod), table.p(2000));
+	// Extending again past the cached prefix keeps earlier values.
+	table.p(100000);
+	ASSERT_EQUAL(190569292u, table.p(100));
+
+	BigInt difference = p_exact(1000);
+	difference -= p_exact(999);
+	ASSERT_EQUAL(p_exact(1000), difference + p_exact(999));
+}
 
 bool runAllTests(int argc, char const *argv[]) {
 	cute::suite s { };
     s.push_back(CUTE(factorialTest));
+    s.push_back(CUTE(factorialBigTest));
     s.push_back(CUTE(calcChangeTest));
+    s.push_back(CUTE(calcChangeCountsTest));
+    s.push_back(CUTE(calcChangeBoundedTest));
+    s.push_back(CUTE(coinSystemTest));
+    s.push_back(CUTE(canonicalCoinsTest));
+    s.push_back(CUTE(largeAmountChangeTest));
+    s.push_back(CUTE(changeKernelTest));
     s.push_back(CUTE(calcSumArrayTest));
+    s.push_back(CUTE(calcMinSumsTest));
+    s.push_back(CUTE(formatSumsTest));
+    s.push_back(CUTE(streamingMinSumTest));
     s.push_back(CUTE(partitioningTest));
+    s.push_back(CUTE(stirlingTableTest));
+    s.push_back(CUTE(stirlingRowModTest));
+    s.push_back(CUTE(constTablesTest));
+    s.push_back(CUTE(memoizationTest));
+    s.push_back(CUTE(binomialModPTest));
+    s.push_back(CUTE(partitionTableTest));
 	cute::xml_file_opener xmlfile(argc, argv);
 	cute::xml_listener<cute::ide_listener<>> lis(xmlfile.out);
 	auto runner = cute::makeRunner(lis, argc, argv);
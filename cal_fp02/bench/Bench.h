@@ -0,0 +1,15 @@
+/*
+ * Bench.h
+ *
+ */
+
+#ifndef BENCH_H_
+#define BENCH_H_
+
+/**
+ * Tempos do GenericSudoku a 9x9, 16x16 e 25x25 sobre puzzles gerados
+ * (grelhas completas baralhadas com parte das celulas apagadas).
+ */
+void benchGenericSizes(int reps);
+
+#endif /* BENCH_H_ */
@@ -0,0 +1,108 @@
+/*
+ * GenericBench.cpp
+ *
+ */
+
+#include "Bench.h"
+#include "../src/GenericSudoku.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+/**
+ * Grelha completa valida (padrao classico) baralhada por operacoes que
+ * preservam as regras: numeros, linhas dentro de cada faixa, faixas,
+ * colunas dentro de cada pilha e pilhas. Depois apaga cada celula com
+ * probabilidade holes.
+ */
+template <int BoxSize>
+string randomPuzzle(mt19937 &rng, double holes)
+{
+	const int N = BoxSize * BoxSize;
+	auto shuffledOrder = [&]()
+	{
+		vector<int> bands(BoxSize), order;
+		iota(bands.begin(), bands.end(), 0);
+		shuffle(bands.begin(), bands.end(), rng);
+		for (int band : bands)
+		{
+			vector<int> inside(BoxSize);
+			iota(inside.begin(), inside.end(), 0);
+			shuffle(inside.begin(), inside.end(), rng);
+			for (int k : inside)
+				order.push_back(band * BoxSize + k);
+		}
+		return order;
+	};
+	vector<int> rows = shuffledOrder(), columns = shuffledOrder(), numbers(N);
+	iota(numbers.begin(), numbers.end(), 1);
+	shuffle(numbers.begin(), numbers.end(), rng);
+
+	bernoulli_distribution erase(holes);
+	string puzzle(N * N, '.');
+	for (int r = 0; r < N; r++)
+	{
+		for (int c = 0; c < N; c++)
+		{
+			int i = rows[r], j = columns[c];
+			int n = numbers[(BoxSize * (i % BoxSize) + i / BoxSize + j) % N];
+			if (!erase(rng))
+				puzzle[r * N + c] = n <= 9 ? '0' + n : 'A' + n - 10;
+		}
+	}
+	return puzzle;
+}
+
+/* threads = 0 usa solve(); caso contrario solveParallel(threads) */
+template <int BoxSize>
+void benchSize(int reps, int count, double holes, unsigned threads = 0)
+{
+	const int N = BoxSize * BoxSize;
+	mt19937 rng(2019 + N);
+	vector<double> samples;
+	int solved = 0;
+	GenericSudoku<BoxSize> sudoku;
+	for (int p = 0; p < count; p++)
+	{
+		string puzzle = randomPuzzle<BoxSize>(rng, holes);
+		vector<double> times;
+		for (int r = 0; r < reps; r++)
+		{
+			auto start = chrono::steady_clock::now();
+			sudoku.load(puzzle.c_str());
+			bool ok = threads == 0 ? sudoku.solve() : sudoku.solveParallel(threads);
+			chrono::duration<double, micro> elapsed = chrono::steady_clock::now() - start;
+			times.push_back(elapsed.count());
+			solved += ok && r == 0;
+		}
+		sort(times.begin(), times.end());
+		samples.push_back(times[times.size() / 2]);
+	}
+	sort(samples.begin(), samples.end());
+	cout << left << setw(10) << (to_string(N) + "x" + to_string(N)) << right
+		<< setw(9) << (threads == 0 ? string("serial") : to_string(threads))
+		<< setw(12) << sizeof(typename GenericSudoku<BoxSize>::Mask) * 8
+		<< setw(10) << count << setw(10) << solved << fixed << setprecision(1)
+		<< setw(14) << samples[samples.size() / 2]
+		<< setw(14) << samples.back() << endl;
+}
+}
+
+void benchGenericSizes(int reps)
+{
+	cout << left << setw(10) << "size" << right << setw(9) << "threads" << setw(12) << "mask bits" << setw(10) << "puzzles"
+		<< setw(10) << "solved" << setw(14) << "median (us)" << setw(14) << "max (us)" << endl;
+	// Mais buracos a 25x25 caem na zona de transicao em que o retrocesso
+	// simples tem tempos de cauda muito longos.
+	benchSize<3>(reps, 200, 0.65);
+	benchSize<4>(reps, 50, 0.60);
+	benchSize<4>(reps, 50, 0.60, 4);
+	benchSize<5>(reps, 20, 0.45);
+}
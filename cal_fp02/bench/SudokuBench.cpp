@@ -0,0 +1,225 @@
+/*
+ * SudokuBench.cpp
+ *
+ * Compara os algoritmos de Sudoku::solve num conjunto de puzzles dificeis.
+ * Uso: ./bench_app [ficheiro de puzzles] [repeticoes]
+ *      ./bench_app --batch entrada [saida] [threads] [dlx]
+ */
+
+#include "../src/Sudoku.h"
+#include "../src/SudokuBatch.h"
+#include "../src/SudokuGenerator.h"
+#include "Bench.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <thread>
+#include <iomanip>
+
+struct Puzzle
+{
+	string name;
+	int cells[9][9];
+};
+
+/* Le o formato de 81 caracteres por linha; '#' inicia um comentario que da nome ao puzzle seguinte. */
+static vector<Puzzle> readPuzzles(const string &path)
+{
+	vector<Puzzle> puzzles;
+	ifstream in(path);
+	string line, name;
+	while (getline(in, line))
+	{
+		if (line.empty())
+			continue;
+		if (line[0] == '#')
+		{
+			name = line.substr(line.find_first_not_of("# "));
+			continue;
+		}
+		if (line.size() < 81)
+			continue;
+		Puzzle puzzle;
+		puzzle.name = name.empty() ? "puzzle " + to_string(puzzles.size() + 1) : name;
+		for (int k = 0; k < 81; k++)
+			puzzle.cells[k / 9][k % 9] = (line[k] >= '1' && line[k] <= '9') ? line[k] - '0' : 0;
+		puzzles.push_back(puzzle);
+		name.clear();
+	}
+	return puzzles;
+}
+
+/* Estatisticas da pesquisa com retrocesso (uma execucao instrumentada). */
+static SolverStats searchStats(Puzzle &puzzle)
+{
+	SolverStats stats;
+	Sudoku s(puzzle.cells);
+	s.solve(stats);
+	return stats;
+}
+
+/* Mediana do tempo (microssegundos) de carregar e resolver o puzzle, reutilizando
+ * a mesma instancia como no modo --batch (a matriz da DLX e construida uma vez,
+ * fora da medicao). */
+static double timeSolve(Puzzle &puzzle, SudokuSolver solver, bool propagation, int reps, bool &solved)
+{
+	char line[81];
+	Sudoku(puzzle.cells).store(line);
+	Sudoku s(solver);
+	s.setPropagationEnabled(propagation);
+	s.load(line);
+	s.solve();
+
+	vector<double> samples;
+	for (int r = 0; r < reps; r++)
+	{
+		auto start = chrono::steady_clock::now();
+		s.load(line);
+		solved = s.solve();
+		chrono::duration<double, micro> elapsed = chrono::steady_clock::now() - start;
+		samples.push_back(elapsed.count());
+	}
+	sort(samples.begin(), samples.end());
+	return samples[samples.size() / 2];
+}
+
+/* Debito de countSolutions(2) (verificacao de unicidade) sobre os puzzles lidos. */
+static void benchUniqueness(const vector<Puzzle> &puzzles, int reps)
+{
+	vector<string> lines;
+	for (const Puzzle &puzzle : puzzles)
+	{
+		string line(81, '.');
+		for (int k = 0; k < 81; k++)
+			if (puzzle.cells[k / 9][k % 9] != 0)
+				line[k] = '0' + puzzle.cells[k / 9][k % 9];
+		lines.push_back(line);
+	}
+
+	int checks = 0, unique = 0;
+	Sudoku sudoku;
+	GenericSudoku<3> generic;
+	auto start = chrono::steady_clock::now();
+	for (int r = 0; r < reps; r++)
+		for (const string &line : lines)
+		{
+			sudoku.load(line.c_str());
+			unique += sudoku.countSolutions(2) == 1;
+			checks++;
+		}
+	chrono::duration<double> sudokuTime = chrono::steady_clock::now() - start;
+
+	start = chrono::steady_clock::now();
+	for (int r = 0; r < reps; r++)
+		for (const string &line : lines)
+		{
+			generic.load(line.c_str());
+			generic.countSolutions(2);
+		}
+	chrono::duration<double> genericTime = chrono::steady_clock::now() - start;
+
+	cout << fixed << setprecision(0) << "uniqueness checks: " << unique << "/" << checks << " unique, "
+		<< checks / sudokuTime.count() << " puzzles/s (Sudoku), "
+		<< checks / genericTime.count() << " puzzles/s (GenericSudoku<3>)" << endl;
+}
+
+/* Debito do gerador em todos os nucleos e distribuicao das dificuldades. */
+static void benchGenerator(size_t count)
+{
+	auto start = chrono::steady_clock::now();
+	vector<GeneratedPuzzle> puzzles = generatePuzzles(count);
+	chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+	vector<long> difficulties;
+	double clues = 0;
+	for (const GeneratedPuzzle &puzzle : puzzles)
+	{
+		difficulties.push_back(puzzle.difficulty);
+		clues += puzzle.clues;
+	}
+	sort(difficulties.begin(), difficulties.end());
+	cout << fixed << setprecision(1) << "generator: " << puzzles.size() << " puzzles in " << elapsed.count()
+		<< " s (" << puzzles.size() / elapsed.count() << "/s, " << thread::hardware_concurrency()
+		<< " threads), mean clues " << clues / puzzles.size()
+		<< ", difficulty p50 " << difficulties[difficulties.size() / 2]
+		<< ", max " << difficulties.back() << endl;
+}
+
+/* Resolve um ficheiro inteiro com SudokuBatch e mostra o debito e as latencias. */
+static int runBatch(int argc, char const *argv[])
+{
+	if (argc < 3)
+	{
+		cerr << "usage: " << argv[0] << " --batch input [output] [threads] [dlx]" << endl;
+		return EXIT_FAILURE;
+	}
+	string output = argc > 3 ? argv[3] : "/dev/null";
+	unsigned threads = argc > 4 ? atoi(argv[4]) : 0;
+	SudokuSolver solver = argc > 5 && string(argv[5]) == "dlx" ? DLX_SOLVER : BACKTRACKING_SOLVER;
+
+	BatchReport report;
+	try
+	{
+		report = solveBatchFile(argv[2], output, threads, solver);
+	}
+	catch (int)
+	{
+		cerr << "cannot read " << argv[2] << " or write " << output << endl;
+		return EXIT_FAILURE;
+	}
+	cout << fixed << setprecision(1)
+		<< "puzzles " << report.puzzles << ", solved " << report.solved
+		<< ", " << report.seconds << " s, " << report.puzzlesPerSecond << " puzzles/s" << endl
+		<< "latency (us): p50 " << report.p50Us << ", p90 " << report.p90Us
+		<< ", p99 " << report.p99Us << ", max " << report.maxUs << endl;
+	return EXIT_SUCCESS;
+}
+
+int main(int argc, char const *argv[])
+{
+	if (argc > 1 && string(argv[1]) == "--batch")
+		return runBatch(argc, argv);
+
+	string path = argc > 1 ? argv[1] : "bench/hard_puzzles.txt";
+	int reps = argc > 2 ? atoi(argv[2]) : 5;
+	vector<Puzzle> puzzles = readPuzzles(path);
+	if (puzzles.empty())
+	{
+		cerr << "no puzzles read from " << path << endl;
+		return EXIT_FAILURE;
+	}
+
+	cout << left << setw(50) << "puzzle" << right << setw(18) << "backtracking (us)"
+		<< setw(18) << "no propagation" << setw(12) << "dlx (us)" << setw(10) << "speedup"
+		<< setw(10) << "nodes" << setw(12) << "backtracks" << endl;
+	double totalBacktracking = 0, totalPlain = 0, totalDlx = 0;
+	for (Puzzle &puzzle : puzzles)
+	{
+		bool solvedBacktracking, solvedPlain, solvedDlx;
+		double backtracking = timeSolve(puzzle, BACKTRACKING_SOLVER, true, reps, solvedBacktracking);
+		double plain = timeSolve(puzzle, BACKTRACKING_SOLVER, false, reps, solvedPlain);
+		double dlx = timeSolve(puzzle, DLX_SOLVER, true, reps, solvedDlx);
+		totalBacktracking += backtracking;
+		totalPlain += plain;
+		totalDlx += dlx;
+		cout << left << setw(50) << puzzle.name.substr(0, 48) << right << fixed << setprecision(1)
+			<< setw(18) << backtracking << setw(18) << plain << setw(12) << dlx
+			<< setw(9) << backtracking / dlx << "x";
+		SolverStats stats = searchStats(puzzle);
+		cout << setw(10) << stats.nodes << setw(12) << stats.backtracks;
+		if (!solvedBacktracking || !solvedPlain || !solvedDlx)
+			cout << "  (unsolved)";
+		cout << endl;
+	}
+	cout << left << setw(50) << "total" << right << setw(18) << totalBacktracking << setw(18) << totalPlain
+		<< setw(12) << totalDlx << setw(9) << totalBacktracking / totalDlx << "x" << endl;
+
+	cout << endl;
+	benchUniqueness(puzzles, 20 * reps);
+
+	benchGenerator(100);
+
+	cout << endl;
+	benchGenericSizes(reps);
+	return EXIT_SUCCESS;
+}
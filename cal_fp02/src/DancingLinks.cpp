@@ -0,0 +1,139 @@
+/*
+ * DancingLinks.cpp
+ *
+ */
+
+#include "DancingLinks.h"
+
+/* O no 0 e a raiz; os nos 1..numColumns sao os cabecalhos das colunas. */
+DancingLinks::DancingLinks(int numColumns) : nodes(numColumns + 1), columnSize(numColumns + 1, 0), numRows(0)
+{
+	for (int c = 0; c <= numColumns; c++)
+	{
+		nodes[c].left = c == 0 ? numColumns : c - 1;
+		nodes[c].right = c == numColumns ? 0 : c + 1;
+		nodes[c].up = nodes[c].down = c;
+		nodes[c].column = c;
+		nodes[c].row = -1;
+	}
+}
+
+int DancingLinks::addRow(const int *columns, int count)
+{
+	int first = nodes.size();
+	rowFirst.push_back(first);
+	for (int i = 0; i < count; i++)
+	{
+		int header = columns[i] + 1;
+		int id = nodes.size();
+		Node node;
+		node.column = header;
+		node.row = numRows;
+		node.up = nodes[header].up;
+		node.down = header;
+		node.left = i == 0 ? id : id - 1;
+		node.right = first;
+		nodes.push_back(node);
+
+		nodes[nodes[header].up].down = id;
+		nodes[header].up = id;
+		nodes[node.left].right = id;
+		nodes[first].left = id;
+		columnSize[header]++;
+	}
+	return numRows++;
+}
+
+void DancingLinks::cover(int column)
+{
+	nodes[nodes[column].right].left = nodes[column].left;
+	nodes[nodes[column].left].right = nodes[column].right;
+	for (int i = nodes[column].down; i != column; i = nodes[i].down)
+	{
+		for (int j = nodes[i].right; j != i; j = nodes[j].right)
+		{
+			nodes[nodes[j].down].up = nodes[j].up;
+			nodes[nodes[j].up].down = nodes[j].down;
+			columnSize[nodes[j].column]--;
+		}
+	}
+}
+
+void DancingLinks::uncover(int column)
+{
+	for (int i = nodes[column].up; i != column; i = nodes[i].up)
+	{
+		for (int j = nodes[i].left; j != i; j = nodes[j].left)
+		{
+			columnSize[nodes[j].column]++;
+			nodes[nodes[j].down].up = j;
+			nodes[nodes[j].up].down = j;
+		}
+	}
+	nodes[nodes[column].right].left = column;
+	nodes[nodes[column].left].right = column;
+}
+
+void DancingLinks::select(int row)
+{
+	int first = rowFirst[row];
+	cover(nodes[first].column);
+	for (int j = nodes[first].right; j != first; j = nodes[j].right)
+		cover(nodes[j].column);
+	selected.push_back(row);
+}
+
+void DancingLinks::deselectAll()
+{
+	while (!selected.empty())
+	{
+		int first = rowFirst[selected.back()];
+		selected.pop_back();
+		for (int j = nodes[first].left; j != first; j = nodes[j].left)
+			uncover(nodes[j].column);
+		uncover(nodes[first].column);
+	}
+}
+
+bool DancingLinks::search(vector<int> &solution)
+{
+	if (nodes[0].right == 0)
+	{
+		solution = partial;
+		return true;
+	}
+
+	int best = nodes[0].right;
+	for (int c = nodes[best].right; c != 0 && columnSize[best] > 1; c = nodes[c].right)
+		if (columnSize[c] < columnSize[best])
+			best = c;
+	if (columnSize[best] == 0)
+		return false;
+
+	cover(best);
+	for (int r = nodes[best].down; r != best; r = nodes[r].down)
+	{
+		partial.push_back(nodes[r].row);
+		for (int j = nodes[r].right; j != r; j = nodes[j].right)
+			cover(nodes[j].column);
+
+		bool found = search(solution);
+
+		for (int j = nodes[r].left; j != r; j = nodes[j].left)
+			uncover(nodes[j].column);
+		partial.pop_back();
+		if (found)
+		{
+			uncover(best);
+			return true;
+		}
+	}
+	uncover(best);
+	return false;
+}
+
+bool DancingLinks::solve(vector<int> &solution)
+{
+	partial.clear();
+	return search(solution);
+}
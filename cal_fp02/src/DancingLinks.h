@@ -0,0 +1,79 @@
+/*
+ * DancingLinks.h
+ *
+ */
+
+#ifndef DANCINGLINKS_H_
+#define DANCINGLINKS_H_
+
+#include <vector>
+
+using namespace std;
+
+/**
+ * Problema de cobertura exata resolvido pelo Algoritmo X de Knuth com
+ * "dancing links": cada 1 da matriz e um no ligado aos vizinhos da linha e
+ * da coluna, e cobrir/descobrir uma coluna e so religar ponteiros.
+ * Os nos vivem num unico vector (indices em vez de ponteiros).
+ * Escolhe sempre a coluna com menos nos (heuristica S de Knuth).
+ * A mesma matriz pode servir para muitos problemas: as linhas ja decididas
+ * (p.ex. as pistas de um Sudoku) sao selecionadas antes de solve() e
+ * deselectAll() repoe a matriz como estava.
+ */
+class DancingLinks
+{
+	struct Node
+	{
+		int left, right, up, down;
+		int column;
+		int row;
+	};
+
+	vector<Node> nodes;
+	vector<int> columnSize;
+	vector<int> rowFirst;
+	vector<int> partial;
+	vector<int> selected;
+	int numRows;
+
+	void cover(int column);
+	void uncover(int column);
+	bool search(vector<int> &solution);
+
+public:
+	/**
+	 * Cria a matriz vazia com o numero de colunas indicado.
+	 * Todas as colunas tem de ser cobertas exatamente uma vez.
+	 */
+	DancingLinks(int numColumns = 0);
+
+	/**
+	 * Acrescenta uma linha com 1s nas colunas indicadas e devolve o seu indice.
+	 */
+	int addRow(const int *columns, int count);
+
+	int getNumRows() const
+	{
+		return numRows;
+	}
+
+	/**
+	 * Fixa a linha row como parte da solucao, cobrindo as suas colunas.
+	 * Nenhuma dessas colunas pode ja estar coberta.
+	 */
+	void select(int row);
+
+	/**
+	 * Desfaz todas as selecoes, pela ordem inversa.
+	 */
+	void deselectAll();
+
+	/**
+	 * Procura uma cobertura exata das colunas que nao estao cobertas por
+	 * linhas selecionadas; em caso de sucesso solution fica com os indices
+	 * das linhas escolhidas pela pesquisa (sem as selecionadas).
+	 */
+	bool solve(vector<int> &solution);
+};
+
+#endif /* DANCINGLINKS_H_ */
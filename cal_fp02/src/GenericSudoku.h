@@ -0,0 +1,734 @@
+/*
+ * GenericSudoku.h
+ *
+ */
+
+#ifndef GENERICSUDOKU_H_
+#define GENERICSUDOKU_H_
+
+#include "DancingLinks.h"
+#include "SolverStats.h"
+#include "WorkStealing.h"
+#include <array>
+#include <atomic>
+#include <stdint.h>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+/**
+ * Resultado de uma resolucao paralela: tarefas criadas na divisao inicial e,
+ * por thread, nos explorados, tarefas executadas, tarefas roubadas e tarefas
+ * cedidas a threads sem trabalho (divisao dinamica).
+ */
+struct ParallelStats
+{
+	int tasks;
+	vector<long> nodesPerThread;
+	vector<int> tasksPerThread;
+	vector<int> stealsPerThread;
+	vector<int> splitsPerThread;
+};
+
+/**
+ * Sudoku de tamanho N x N com blocos BoxSize x BoxSize (N = BoxSize^2):
+ * 9x9, 16x16, 25x25, ...
+ * O tamanho e fixo em tempo de compilacao, por isso os ciclos internos nao
+ * verificam dimensoes e o tipo das mascaras de candidatos e o mais pequeno
+ * que chega: uint16_t ate 16 numeros, uint32_t ate 32, uint64_t ate 64.
+ * O bit n-1 da mascara representa o numero n.
+ *
+ * E o motor de todos os tamanhos (Sudoku 9x9 e uma fachada sobre
+ * GenericSudoku<3>): naked e hidden singles e candidatos bloqueados ate ao
+ * ponto fixo, escolha da celula com menos candidatos e retrocesso, ou
+ * cobertura exata (solveDlx). As jogadas e os candidatos eliminados ficam em
+ * rastos (trail) e desfazer uma tentativa e so recuar nos rastos, sem copias
+ * do tabuleiro na pilha. As estatisticas da pesquisa seguem a politica Stats
+ * (NoStats ou SolverStats, ver SolverStats.h).
+ */
+template <int BoxSize>
+class GenericSudoku
+{
+public:
+	static const int N = BoxSize * BoxSize;
+	static const int CELLS = N * N;
+
+	static_assert(BoxSize >= 2 && N <= 64, "GenericSudoku supports boxes from 2x2 to 8x8");
+
+	typedef typename conditional<N <= 16, uint16_t,
+			typename conditional<N <= 32, uint32_t, uint64_t>::type>::type Mask;
+
+	static const Mask FULL_MASK = N == 64 ? Mask(~Mask(0)) : Mask((uint64_t(1) << N) - 1);
+
+private:
+	array<uint8_t, CELLS> cells;
+	array<Mask, N> lineMask;
+	array<Mask, N> columnMask;
+	array<Mask, N> blockMask;
+	array<Mask, CELLS> eliminated;
+	array<uint16_t, CELLS> trail;
+	vector<pair<uint16_t, Mask> > eliminations;
+	int countFilled;
+	bool propagationEnabled;
+	long nodes;
+	const atomic<bool> *cancelled;
+
+	/* Estado de uma resolucao paralela visto pela thread que corre a tarefa */
+	struct Sharing
+	{
+		WorkStealingDeque<GenericSudoku> *queue;
+		atomic<int> *idle;
+		atomic<long> *pending;
+		int splits;
+	};
+	Sharing *sharing;
+
+	static int blockOf(int i, int j) { return (i / BoxSize) * BoxSize + j / BoxSize; }
+	static int popcount(Mask m) { return __builtin_popcountll(m); }
+	static int lowestNumber(Mask m) { return __builtin_ctzll(m) + 1; }
+
+	/* Celulas de cada unidade: linhas 0..N-1, colunas N..2N-1, blocos 2N..3N-1 */
+	static const array<array<uint16_t, N>, 3 * N> &units()
+	{
+		static const array<array<uint16_t, N>, 3 * N> table = []()
+		{
+			array<array<uint16_t, N>, 3 * N> t;
+			for (int u = 0; u < N; u++)
+			{
+				for (int k = 0; k < N; k++)
+				{
+					t[u][k] = u * N + k;
+					t[N + u][k] = k * N + u;
+					t[2 * N + u][k] = ((u / BoxSize) * BoxSize + k / BoxSize) * N
+							+ (u % BoxSize) * BoxSize + k % BoxSize;
+				}
+			}
+			return t;
+		}();
+		return table;
+	}
+
+	Mask candidatesAt(int cell) const
+	{
+		int i = cell / N, j = cell % N;
+		return ~(lineMask[i] | columnMask[j] | blockMask[blockOf(i, j)] | eliminated[cell]) & FULL_MASK;
+	}
+
+	void place(int cell, int n)
+	{
+		int i = cell / N, j = cell % N;
+		Mask bit = Mask(1) << (n - 1);
+		cells[cell] = n;
+		lineMask[i] |= bit;
+		columnMask[j] |= bit;
+		blockMask[blockOf(i, j)] |= bit;
+		trail[countFilled++] = cell;
+	}
+
+	/* Retira os numeros em bits dos candidatos da celula, guardando-os no rasto */
+	void eliminate(int cell, Mask bits)
+	{
+		eliminated[cell] |= bits;
+		eliminations.push_back(make_pair(cell, bits));
+	}
+
+	/* Desfaz as jogadas e eliminacoes ate os rastos voltarem a ter mark celulas
+	 * e eliminationMark eliminacoes */
+	void undo(int mark, size_t eliminationMark)
+	{
+		while (eliminations.size() > eliminationMark)
+		{
+			eliminated[eliminations.back().first] &= ~eliminations.back().second;
+			eliminations.pop_back();
+		}
+		while (countFilled > mark)
+		{
+			int cell = trail[--countFilled];
+			int i = cell / N, j = cell % N;
+			Mask bit = Mask(1) << (cells[cell] - 1);
+			cells[cell] = 0;
+			lineMask[i] &= ~bit;
+			columnMask[j] &= ~bit;
+			blockMask[blockOf(i, j)] &= ~bit;
+		}
+	}
+
+	/**
+	 * Candidatos bloqueados: para cada
+	 * segmento (intersecao de uma linha ou coluna com um bloco), os numeros
+	 * que no bloco so aparecem no segmento saem do resto da linha/coluna
+	 * (pointing) e os que na linha/coluna so aparecem no segmento saem do
+	 * resto do bloco (claiming). Retorna true se eliminou algum candidato.
+	 */
+	template <class Stats>
+	bool lockedCandidates(Stats &stats)
+	{
+		array<array<Mask, BoxSize>, N> lineSegment, columnSegment;
+		for (int u = 0; u < N; u++)
+		{
+			lineSegment[u].fill(0);
+			columnSegment[u].fill(0);
+		}
+		for (int cell = 0; cell < CELLS; cell++)
+		{
+			if (cells[cell] != 0)
+				continue;
+			int i = cell / N, j = cell % N;
+			Mask options = candidatesAt(cell);
+			lineSegment[i][j / BoxSize] |= options;
+			columnSegment[j][i / BoxSize] |= options;
+		}
+
+		long removed = 0;
+		for (int columns = 0; columns < 2; columns++)
+		{
+			const array<array<Mask, BoxSize>, N> &segment = columns ? columnSegment : lineSegment;
+			for (int line = 0; line < N; line++)
+			{
+				int base = line - line % BoxSize;
+				for (int s = 0; s < BoxSize; s++)
+				{
+					Mask restOfLine = 0, restOfBlock = 0;
+					for (int k = 0; k < BoxSize; k++)
+					{
+						if (k != s)
+							restOfLine |= segment[line][k];
+						if (base + k != line)
+							restOfBlock |= segment[base + k][s];
+					}
+					Mask pointing = segment[line][s] & ~restOfBlock;
+					Mask claiming = segment[line][s] & ~restOfLine;
+					if (pointing == 0 && claiming == 0)
+						continue;
+
+					for (int k = 0; k < N; k++)
+					{
+						// k-esima celula fora do segmento na linha, ou no bloco
+						int other = k / BoxSize == s ? -1 : columns ? k * N + line : line * N + k;
+						if (other >= 0 && cells[other] == 0 && (candidatesAt(other) & pointing))
+						{
+							removed += popcount(candidatesAt(other) & pointing);
+							eliminate(other, candidatesAt(other) & pointing);
+						}
+						int row = base + k / BoxSize, col = s * BoxSize + k % BoxSize;
+						int blockCell = columns ? col * N + row : row * N + col;
+						if (row != line && cells[blockCell] == 0 && (candidatesAt(blockCell) & claiming))
+						{
+							removed += popcount(candidatesAt(blockCell) & claiming);
+							eliminate(blockCell, candidatesAt(blockCell) & claiming);
+						}
+					}
+				}
+			}
+		}
+		if (removed == 0)
+			return false;
+		stats.onLockedCandidates(removed);
+		return true;
+	}
+
+	/* Naked e hidden singles e candidatos bloqueados ate nada mudar; false se
+	 * houver contradicao */
+	template <class Stats>
+	bool propagate(Stats &stats)
+	{
+		bool changed = true;
+		while (changed && countFilled < CELLS)
+		{
+			changed = false;
+			for (int cell = 0; cell < CELLS; cell++)
+			{
+				if (cells[cell] != 0)
+					continue;
+				Mask options = candidatesAt(cell);
+				if (options == 0)
+					return false;
+				if ((options & (options - 1)) == 0)
+				{
+					place(cell, lowestNumber(options));
+					stats.onNakedSingle();
+					changed = true;
+				}
+			}
+
+			for (const array<uint16_t, N> &unit : units())
+			{
+				Mask once = 0, twice = 0, placed = 0;
+				for (int cell : unit)
+				{
+					if (cells[cell] != 0)
+						placed |= Mask(1) << (cells[cell] - 1);
+					else
+					{
+						Mask options = candidatesAt(cell);
+						twice |= once & options;
+						once |= options;
+					}
+				}
+				if ((once | placed) != FULL_MASK)
+					return false;
+
+				for (Mask singles = once & ~twice & ~placed; singles != 0; singles &= singles - 1)
+				{
+					int n = lowestNumber(singles);
+					Mask bit = singles & -singles;
+					int target = -1;
+					for (int cell : unit)
+					{
+						if (cells[cell] == 0 && (candidatesAt(cell) & bit))
+						{
+							target = cell;
+							break;
+						}
+					}
+					if (target < 0)
+						return false; // a celula ja foi usada por outro numero
+					place(target, n);
+					stats.onHiddenSingle();
+					changed = true;
+				}
+			}
+			if (!changed)
+				changed = lockedCandidates(stats);
+		}
+		return true;
+	}
+
+	/* Celula vazia com menos candidatos (-1 se completo) */
+	int chooseCell(Mask &options) const
+	{
+		int best = -1, fewest = N + 1;
+		for (int cell = 0; cell < CELLS; cell++)
+		{
+			if (cells[cell] != 0)
+				continue;
+			Mask cellOptions = candidatesAt(cell);
+			int count = popcount(cellOptions);
+			if (count < fewest)
+			{
+				fewest = count;
+				best = cell;
+				options = cellOptions;
+				if (count <= 1)
+					break;
+			}
+		}
+		return best;
+	}
+
+	/**
+	 * Divisao dinamica: ha threads paradas, por isso os ramos ainda por
+	 * tentar nesta celula passam a ser tarefas na fila desta thread, de onde
+	 * as outras os podem roubar.
+	 */
+	void donate(int cell, Mask options)
+	{
+		for (; options != 0; options &= options - 1)
+		{
+			GenericSudoku task(*this);
+			task.place(cell, lowestNumber(options));
+			sharing->pending->fetch_add(1);
+			sharing->queue->push(move(task));
+			sharing->splits++;
+		}
+	}
+
+	template <class Stats>
+	bool solveRecursive(Stats &stats)
+	{
+		nodes++;
+		stats.onNode();
+		if (cancelled != nullptr && cancelled->load(memory_order_relaxed))
+			return false;
+
+		int mark = countFilled;
+		size_t eliminationMark = eliminations.size();
+		if (propagationEnabled && !propagate(stats))
+		{
+			undo(mark, eliminationMark);
+			return false;
+		}
+
+		Mask options = 0;
+		int cell = chooseCell(options);
+		if (cell < 0)
+			return true;
+
+		if (options != 0)
+			stats.onBranch(popcount(options));
+		int afterPropagation = countFilled;
+		size_t eliminationsAfterPropagation = eliminations.size();
+		for (; options != 0; options &= options - 1)
+		{
+			if (sharing != nullptr && (options & (options - 1)) != 0
+					&& sharing->idle->load(memory_order_relaxed) > 0)
+			{
+				donate(cell, options & (options - 1));
+				options &= -options;
+			}
+			place(cell, lowestNumber(options));
+			if (solveRecursive(stats))
+				return true;
+			stats.onBacktrack();
+			undo(afterPropagation, eliminationsAfterPropagation);
+		}
+		undo(mark, eliminationMark);
+		return false;
+	}
+
+	void countRecursive(int limit, int &count)
+	{
+		nodes++;
+		NoStats stats;
+		int mark = countFilled;
+		size_t eliminationMark = eliminations.size();
+		if (!propagationEnabled || propagate(stats))
+		{
+			Mask options = 0;
+			int cell = chooseCell(options);
+			if (cell < 0)
+				count++;
+			int afterPropagation = countFilled;
+			size_t eliminationsAfterPropagation = eliminations.size();
+			for (; cell >= 0 && options != 0 && count < limit; options &= options - 1)
+			{
+				place(cell, lowestNumber(options));
+				countRecursive(limit, count);
+				undo(afterPropagation, eliminationsAfterPropagation);
+			}
+		}
+		undo(mark, eliminationMark);
+	}
+
+	/**
+	 * Divide a arvore de pesquisa nos primeiros niveis de ramificacao ate haver
+	 * pelo menos target tabuleiros (ou maxDepth niveis). Retorna true se a
+	 * propria divisao encontrar uma solucao, que fica em *this. Cada tabuleiro
+	 * expandido conta como um no, tal como em solveRecursive.
+	 */
+	bool split(vector<GenericSudoku> &frontier, size_t target, int maxDepth)
+	{
+		frontier.assign(1, *this);
+		for (int depth = 0; depth < maxDepth && !frontier.empty() && frontier.size() < target; depth++)
+		{
+			vector<GenericSudoku> next;
+			for (GenericSudoku &board : frontier)
+			{
+				nodes++;
+				NoStats stats;
+				if (board.propagationEnabled && !board.propagate(stats))
+					continue;
+				Mask options = 0;
+				int cell = board.chooseCell(options);
+				if (cell < 0)
+				{
+					long expanded = nodes;
+					*this = board;
+					nodes = expanded;
+					return true;
+				}
+				for (; options != 0; options &= options - 1)
+				{
+					next.push_back(board);
+					next.back().place(cell, lowestNumber(options));
+				}
+			}
+			frontier.swap(next);
+		}
+		return false;
+	}
+
+public:
+	GenericSudoku() : propagationEnabled(true), nodes(0), cancelled(nullptr), sharing(nullptr)
+	{
+		clear();
+	}
+
+	/**
+	 * Esvazia o tabuleiro.
+	 */
+	void clear()
+	{
+		cells.fill(0);
+		lineMask.fill(0);
+		columnMask.fill(0);
+		blockMask.fill(0);
+		eliminated.fill(0);
+		eliminations.clear();
+		countFilled = 0;
+	}
+
+	/**
+	 * Liga ou desliga a propagacao de restricoes (ligada por omissao); sem ela
+	 * a pesquisa e so escolha da celula com menos candidatos e retrocesso.
+	 */
+	void setPropagationEnabled(bool enabled)
+	{
+		propagationEnabled = enabled;
+	}
+
+	/**
+	 * Valor da celula (i, j), de 1 a N, ou 0 se estiver por preencher.
+	 */
+	int get(int i, int j) const
+	{
+		return cells[i * N + j];
+	}
+
+	/**
+	 * Numeros que ainda podem ocupar a celula (i, j) (bit n-1 para o numero n;
+	 * 0 se a celula estiver preenchida).
+	 */
+	Mask candidates(int i, int j) const
+	{
+		int cell = i * N + j;
+		return cells[cell] != 0 ? 0 : candidatesAt(cell);
+	}
+
+	/**
+	 * Coloca n na celula vazia (i, j), se nao repetir nenhum numero.
+	 * Retorna false (sem alterar nada) caso contrario.
+	 */
+	bool set(int i, int j, int n)
+	{
+		int cell = i * N + j;
+		if (n < 1 || n > N || cells[cell] != 0 || !(candidatesAt(cell) >> (n - 1) & 1))
+			return false;
+		place(cell, n);
+		return true;
+	}
+
+	/**
+	 * Carrega um puzzle de CELLS caracteres: '1'-'9' e depois 'A', 'B', ...
+	 * para 10, 11, ...; '0' ou '.' para as celulas vazias.
+	 * Retorna false (e deixa o tabuleiro vazio) se a linha for invalida.
+	 */
+	bool load(const char *line)
+	{
+		clear();
+		for (int cell = 0; cell < CELLS; cell++)
+		{
+			char c = line[cell];
+			if (c == '0' || c == '.')
+				continue;
+			int n = (c >= '1' && c <= '9') ? c - '0' : (c >= 'A' && c <= 'Z') ? c - 'A' + 10 : -1;
+			if (!set(cell / N, cell % N, n))
+			{
+				clear();
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/**
+	 * Escreve o tabuleiro em line (CELLS caracteres, formato de load).
+	 */
+	void store(char *line) const
+	{
+		for (int cell = 0; cell < CELLS; cell++)
+		{
+			int n = cells[cell];
+			line[cell] = n == 0 ? '.' : n <= 9 ? '0' + n : 'A' + n - 10;
+		}
+	}
+
+	bool isComplete() const
+	{
+		return countFilled == CELLS;
+	}
+
+	/**
+	 * Resolve o Sudoku. Se for impossivel retorna false e deixa o tabuleiro
+	 * como estava.
+	 */
+	bool solve()
+	{
+		NoStats stats;
+		return solveRecursive(stats);
+	}
+
+	/**
+	 * Igual a solve(), acumulando em stats as estatisticas da pesquisa.
+	 */
+	template <class Stats>
+	bool solve(Stats &stats)
+	{
+		return solveRecursive(stats);
+	}
+
+	/**
+	 * Constroi em dlx a matriz de cobertura exata do tabuleiro vazio: 4*CELLS
+	 * colunas (celula preenchida, numero na linha, na coluna, no bloco) e uma
+	 * linha por celula e numero, a linha cell * N + n - 1.
+	 */
+	static void buildExactCover(DancingLinks &dlx)
+	{
+		dlx = DancingLinks(4 * CELLS);
+		for (int cell = 0; cell < CELLS; cell++)
+		{
+			int i = cell / N, j = cell % N;
+			for (int k = 0; k < N; k++)
+			{
+				int columns[4] = { cell, CELLS + i * N + k, 2 * CELLS + j * N + k, 3 * CELLS + blockOf(i, j) * N + k };
+				dlx.addRow(columns, 4);
+			}
+		}
+	}
+
+	/**
+	 * Resolve por cobertura exata sobre uma matriz de buildExactCover, que
+	 * pode ser reutilizada entre chamadas: as celulas preenchidas sao
+	 * selecionadas (cobrindo as suas colunas), a DLX completa o resto e a
+	 * matriz e reposta no fim. rows e so espaco de trabalho. A DLX nao usa a
+	 * propagacao nem e instrumentada.
+	 */
+	bool solveDlx(DancingLinks &dlx, vector<int> &rows)
+	{
+		if (isComplete())
+			return true;
+		if (dlx.getNumRows() == 0)
+			buildExactCover(dlx);
+
+		for (int cell = 0; cell < CELLS; cell++)
+			if (cells[cell] != 0)
+				dlx.select(cell * N + cells[cell] - 1);
+		bool solved = dlx.solve(rows);
+		dlx.deselectAll();
+		if (!solved)
+			return false;
+		for (int row : rows)
+			place(row / N, row % N + 1);
+		return true;
+	}
+
+	/**
+	 * Numero de solucoes, contando no maximo ate limit; nao altera o tabuleiro.
+	 */
+	int countSolutions(int limit = 2)
+	{
+		int count = 0;
+		if (limit > 0)
+			countRecursive(limit, count);
+		return count;
+	}
+
+	/**
+	 * Resolve o Sudoku com numThreads threads (0 = uma por nucleo).
+	 * A arvore de pesquisa e dividida nos primeiros niveis em tarefas
+	 * independentes, repartidas por filas com roubo de trabalho. Enquanto
+	 * houver threads sem trabalho, quem esta a pesquisar cede-lhes os ramos
+	 * ainda por tentar (divisao dinamica). Assim que uma thread encontra uma
+	 * solucao as outras sao canceladas. Os nos de todas as tarefas somam-se a
+	 * getNodes(). Se stats nao for nulo recebe as contagens por thread.
+	 */
+	bool solveParallel(unsigned numThreads = 0, ParallelStats *stats = nullptr)
+	{
+		if (numThreads == 0)
+			numThreads = max(1u, thread::hardware_concurrency());
+
+		vector<GenericSudoku> frontier;
+		bool solvedBySplit = split(frontier, 8 * numThreads, 6);
+		if (stats != nullptr)
+		{
+			stats->tasks = frontier.size();
+			stats->nodesPerThread.assign(numThreads, 0);
+			stats->tasksPerThread.assign(numThreads, 0);
+			stats->stealsPerThread.assign(numThreads, 0);
+			stats->splitsPerThread.assign(numThreads, 0);
+		}
+		if (solvedBySplit)
+			return true;
+
+		vector<WorkStealingDeque<GenericSudoku> > queues(numThreads);
+		for (size_t t = 0; t < frontier.size(); t++)
+			queues[t % numThreads].push(move(frontier[t]));
+
+		// pending conta as tarefas nas filas ou a correr; so chega a zero
+		// quando ja nao ha trabalho nenhum para ceder ou roubar.
+		atomic<bool> found(false);
+		atomic<int> idle(0);
+		atomic<long> pending(frontier.size()), totalNodes(0);
+		mutex resultMutex;
+		auto worker = [&](unsigned self)
+		{
+			Sharing shared = { &queues[self], &idle, &pending, 0 };
+			GenericSudoku task;
+			long nodesHere = 0;
+			int tasksHere = 0, stealsHere = 0;
+			bool waiting = false;
+			while (!found.load(memory_order_relaxed) && pending.load() > 0)
+			{
+				bool have = queues[self].pop(task);
+				for (unsigned k = 1; !have && k < numThreads; k++)
+				{
+					have = queues[(self + k) % numThreads].steal(task);
+					stealsHere += have;
+				}
+				if (!have)
+				{
+					if (!waiting)
+						idle++;
+					waiting = true;
+					this_thread::yield();
+					continue;
+				}
+				if (waiting)
+					idle--;
+				waiting = false;
+
+				tasksHere++;
+				task.nodes = 0;
+				task.cancelled = &found;
+				task.sharing = &shared;
+				NoStats none;
+				bool solved = task.solveRecursive(none);
+				nodesHere += task.nodes;
+				if (solved)
+				{
+					lock_guard<mutex> lock(resultMutex);
+					if (!found.exchange(true))
+					{
+						*this = task;
+						cancelled = nullptr;
+						this->sharing = nullptr;
+					}
+				}
+				pending--;
+			}
+			if (waiting)
+				idle--;
+			totalNodes += nodesHere;
+			if (stats != nullptr)
+			{
+				stats->nodesPerThread[self] = nodesHere;
+				stats->tasksPerThread[self] = tasksHere;
+				stats->stealsPerThread[self] = stealsHere;
+				stats->splitsPerThread[self] = shared.splits;
+			}
+		};
+
+		long nodesBefore = nodes;
+		vector<thread> workers;
+		for (unsigned t = 1; t < numThreads; t++)
+			workers.emplace_back(worker, t);
+		worker(0);
+		for (thread &t : workers)
+			t.join();
+		nodes = nodesBefore + totalNodes.load();
+		return found.load();
+	}
+
+	/**
+	 * Nos da arvore de pesquisa visitados desde que o tabuleiro foi criado.
+	 */
+	long getNodes() const
+	{
+		return nodes;
+	}
+};
+
+#endif /* GENERICSUDOKU_H_ */
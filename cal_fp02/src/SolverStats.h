@@ -0,0 +1,59 @@
+/*
+ * SolverStats.h
+ *
+ */
+
+#ifndef SOLVERSTATS_H_
+#define SOLVERSTATS_H_
+
+/**
+ * Politicas de estatisticas para Sudoku::solve(Stats &) e
+ * GenericSudoku::solve(Stats &).
+ * O solver chama os metodos on...() nos pontos relevantes da pesquisa;
+ * com NoStats sao funcoes vazias inline e o compilador elimina-as, pelo
+ * que a instrumentacao nao custa nada quando nao e pedida.
+ */
+
+/**
+ * Sem estatisticas (usada por solve() e countSolutions()).
+ */
+struct NoStats
+{
+	void onNode() {}
+	void onBacktrack() {}
+	void onBranch(int) {}
+	void onNakedSingle() {}
+	void onHiddenSingle() {}
+	void onLockedCandidates(long) {}
+};
+
+/**
+ * Contadores da pesquisa com retrocesso:
+ *  - nodes: nos visitados (chamadas recursivas, incluindo a raiz);
+ *  - backtracks: tentativas que falharam e foram desfeitas;
+ *  - branchingCandidates[k]: ramificacoes feitas numa celula com k candidatos
+ *    (k ate 64, o maior tamanho de GenericSudoku);
+ *  - nakedSingles, hiddenSingles: celulas preenchidas por cada regra;
+ *  - lockedCandidates: candidatos eliminados por candidatos bloqueados.
+ */
+struct SolverStats
+{
+	long nodes;
+	long backtracks;
+	long branchingCandidates[65];
+	long nakedSingles;
+	long hiddenSingles;
+	long lockedCandidates;
+
+	SolverStats() : nodes(0), backtracks(0), branchingCandidates(), nakedSingles(0), hiddenSingles(0),
+			lockedCandidates(0) {}
+
+	void onNode() { nodes++; }
+	void onBacktrack() { backtracks++; }
+	void onBranch(int candidates) { branchingCandidates[candidates]++; }
+	void onNakedSingle() { nakedSingles++; }
+	void onHiddenSingle() { hiddenSingles++; }
+	void onLockedCandidates(long eliminated) { lockedCandidates += eliminated; }
+};
+
+#endif /* SOLVERSTATS_H_ */
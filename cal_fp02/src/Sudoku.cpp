@@ -7,9 +7,8 @@
 
 /** Inicia um Sudoku vazio.
  */
-Sudoku::Sudoku()
+Sudoku::Sudoku(SudokuSolver solver) : solver(solver)
 {
-	this->initialize();
 }
 
 /**
@@ -19,45 +18,31 @@ Sudoku::Sudoku()
  * por linha, coluna ou bloc 3x3.
  *
  * @param nums matriz com os valores iniciais (0 significa por preencher)
+ * @param solver algoritmo usado por omissao em solve()
  */
-Sudoku::Sudoku(int nums[9][9])
+Sudoku::Sudoku(int nums[9][9], SudokuSolver solver) : solver(solver)
 {
-	this->initialize();
-
 	for (int i = 0; i < 9; i++)
 	{
 		for (int j = 0; j < 9; j++)
 		{
-			if (nums[i][j] != 0)
-			{
-				int n = nums[i][j];
-				numbers[i][j] = n;
-				lineHasNumber[i][n] = true;
-				columnHasNumber[j][n] = true;
-				block3x3HasNumber[i / 3][j / 3][n] = true;
-				countFilled++;
-			}
+			int n = nums[i][j];
+			if (n < 0 || n > 9)
+				throw IllegalArgumentException;
+			if (n != 0 && !board.set(i, j, n))
+				throw IllegalArgumentException;
 		}
 	}
 }
 
-void Sudoku::initialize()
+bool Sudoku::load(const char *line)
 {
-	for (int i = 0; i < 9; i++)
-	{
-		for (int j = 0; j < 9; j++)
-		{
-			for (int n = 0; n < 10; n++)
-			{
-				numbers[i][j] = 0;
-				lineHasNumber[i][n] = false;
-				columnHasNumber[j][n] = false;
-				block3x3HasNumber[i / 3][j / 3][n] = false;
-			}
-		}
-	}
+	return board.load(line);
+}
 
-	this->countFilled = 0;
+void Sudoku::store(char *line) const
+{
+	board.store(line);
 }
 
 /**
@@ -72,7 +57,7 @@ int** Sudoku::getNumbers()
 		ret[i] = new int[9];
 
 		for (int a = 0; a < 9; a++)
-			ret[i][a] = numbers[i][a];
+			ret[i][a] = board.get(i, a);
 	}
 
 	return ret;
@@ -83,49 +68,42 @@ int** Sudoku::getNumbers()
  */
 bool Sudoku::isComplete()
 {
-	return countFilled == 9 * 9;
+	return board.isComplete();
 }
 
-
-
-
-
 /**
  * Resolve o Sudoku.
- * Retorna indica??o de sucesso ou insucesso (sudoku imposs?vel).
+ * Retorna indicacao de sucesso ou insucesso (sudoku impossivel).
  */
 bool Sudoku::solve()
 {
-	vector<int> lowest_solution(10);
-	int multiplicity = 1;
-	int x = -1, y = -1;
-	while (!this->isComplete()){
-        for(int i = 0; i < 10; i++){
-            for(int j = 0; j < 10; j++){
-                vector<int> newest_solution = this->possibleNumbers(i, j);
-                if(newest_solution.size() < lowest_solution.size() && !newest_solution.empty()){
-                    lowest_solution = newest_solution;
-                    x = i;
-                    y = j;
-                }
-            }
-        }
-
-        if(x == -1 && y == -1)
-            return false;
-        this->numbers[x][y] = lowest_solution[0];
-        this->countFilled++;
-        multiplicity*=lowest_solution.size();
-        this->columnHasNumber[x][lowest_solution[0]] = true;
-        this->lineHasNumber[y][lowest_solution[0]] = true;
-        this->block3x3HasNumber[x/3][y/3][lowest_solution[0] - 1] = true;
-        lowest_solution.clear();
-    }
-	cout << "The multiplicity is "  << multiplicity << endl;
-	return this->isComplete();
+	NoStats stats;
+	return solve(solver, stats);
+}
+
+/**
+ * Resolve o Sudoku com o algoritmo indicado.
+ */
+bool Sudoku::solve(SudokuSolver solver)
+{
+	NoStats stats;
+	return solve(solver, stats);
+}
+
+bool Sudoku::solveParallel(unsigned numThreads, ParallelStats *stats)
+{
+	return board.solveParallel(numThreads, stats);
 }
 
+int Sudoku::countSolutions(int limit)
+{
+	return board.countSolutions(limit);
+}
 
+void Sudoku::setPropagationEnabled(bool enabled)
+{
+	board.setPropagationEnabled(enabled);
+}
 
 /**
  * Imprime o Sudoku.
@@ -134,23 +112,19 @@ void Sudoku::print()
 {
 	for (int i = 0; i < 9; i++){
 		for (int a = 0; a < 9; a++)
-			cout << this->numbers[i][a] << " ";
+			cout << board.get(i, a) << " ";
 
 		cout << endl;
 	}
 }
 
-
-
 vector<int> Sudoku::possibleNumbers(int x, int y) {
 	vector<int> possibleSols;
-	for(int i = 1; i <= 9; i++ ){
-		if(isNumberPossible(x, y, i))
-			possibleSols.push_back(i);
-	}
-    return possibleSols;
+	for (uint16_t options = board.candidates(x, y); options != 0; options &= options - 1)
+		possibleSols.push_back(__builtin_ctz(options) + 1);
+	return possibleSols;
 }
 
 bool Sudoku::isNumberPossible(int x, int y, int num) {
-	return (this->columnHasNumber[x][num] || this->lineHasNumber[y][num] || this->block3x3HasNumber[x/3][y/3][num]);
+	return num >= 1 && num <= 9 && (board.candidates(x, y) >> (num - 1) & 1);
 }
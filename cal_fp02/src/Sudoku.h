@@ -13,33 +13,42 @@
 #include <stdlib.h>
 #include <time.h>
 #include <vector>
+#include <stdint.h>
+#include "DancingLinks.h"
+#include "GenericSudoku.h"
+#include "SolverStats.h"
 
 using namespace std;
 
 #define IllegalArgumentException -1
 
+/**
+ * Algoritmo usado por Sudoku::solve: pesquisa com retrocesso sobre as
+ * mascaras de candidatos, ou cobertura exata com dancing links (DLX).
+ */
+enum SudokuSolver { BACKTRACKING_SOLVER, DLX_SOLVER };
+
 class Sudoku
 {
 	/**
-	 * numbers[i][j] - n�mero que ocupa a linha i, coluna j (de 0 a 8)
-	 * 0 quer dizer n�o preenchido.
+	 * Tabuleiro e motor de pesquisa: o Sudoku 9x9 e um GenericSudoku<3>, o
+	 * mesmo motor dos outros tamanhos.
 	 */
-	int numbers[9][9];
+	GenericSudoku<3> board;
+
+	SudokuSolver solver;
 
 	/**
-	 * Informa��o derivada da anterior, para acelerar processamento (n�mero de 1 a 9, nao usa 0)
+	 * Matriz de cobertura exata usada por DLX_SOLVER, construida uma vez por
+	 * instancia, e as linhas da ultima solucao.
 	 */
-	int countFilled;
-	bool columnHasNumber[9][10];
-	bool lineHasNumber[9][10];
-	bool block3x3HasNumber[3][3][10];
-
-	void initialize();
+	DancingLinks dlx;
+	vector<int> dlxRows;
 
 public:
 	/** Inicia um Sudoku vazio.
 	 */
-	Sudoku();
+	Sudoku(SudokuSolver solver = BACKTRACKING_SOLVER);
 
 	/**
 	 * Inicia um Sudoku com um conte�do inicial.
@@ -48,8 +57,23 @@ public:
 	 * por linha, coluna ou bloc 3x3.
 	 *
 	 * @param nums matriz com os valores iniciais (0 significa por preencher)
+	 * @param solver algoritmo usado por omissao em solve()
 	 */
-	Sudoku(int nums[9][9]);
+	Sudoku(int nums[9][9], SudokuSolver solver = BACKTRACKING_SOLVER);
+
+	/**
+	 * Substitui o conteudo por um puzzle no formato de uma linha: 81 caracteres,
+	 * '1' a '9' preenchidos e '0' ou '.' por preencher.
+	 * Retorna false (e deixa o Sudoku vazio) se a linha for invalida ou tiver
+	 * numeros repetidos; permite reutilizar a mesma instancia sem excecoes.
+	 */
+	bool load(const char *line);
+
+	/**
+	 * Escreve o conteudo actual em line, no mesmo formato de 81 caracteres
+	 * ('.' para as celulas por preencher).
+	 */
+	void store(char *line) const;
 
 	/**
 	 * Obtem o conte�do actual (s� para leitura!).
@@ -69,14 +93,65 @@ public:
 	 */
 	bool solve();
 
+	/**
+	 * Resolve o Sudoku com o algoritmo indicado.
+	 */
+	bool solve(SudokuSolver solver);
+
+	/**
+	 * Resolve o Sudoku e acumula em stats as estatisticas da pesquisa com
+	 * retrocesso (a DLX nao e instrumentada). Stats e NoStats ou SolverStats;
+	 * com NoStats o custo e o mesmo de solve().
+	 */
+	template <class Stats>
+	bool solve(SudokuSolver solver, Stats &stats)
+	{
+		return solver == DLX_SOLVER ? board.solveDlx(dlx, dlxRows) : board.solve(stats);
+	}
+
+	template <class Stats>
+	bool solve(Stats &stats)
+	{
+		return solve(solver, stats);
+	}
+
+	/**
+	 * Resolve o Sudoku com varias threads (0 = uma por nucleo), com
+	 * GenericSudoku<3>::solveParallel; stats, se nao for nulo, recebe os nos
+	 * explorados por thread. Util para puzzles com pouca informacao.
+	 * A pesquisa e sempre por retrocesso (DLX_SOLVER so se aplica a solve())
+	 * e respeita setPropagationEnabled.
+	 */
+	bool solveParallel(unsigned numThreads = 0, ParallelStats *stats = nullptr);
+
+	/**
+	 * Numero de solucoes, contando no maximo ate limit (a pesquisa para ai).
+	 * countSolutions(2) == 1 indica que o puzzle tem solucao unica.
+	 * Nao altera o conteudo.
+	 */
+	int countSolutions(int limit = 2);
+
+	/**
+	 * Liga ou desliga a propagacao de restricoes (naked singles, hidden singles
+	 * e candidatos bloqueados) antes e durante a pesquisa com retrocesso.
+	 * Ligada por omissao.
+	 */
+	void setPropagationEnabled(bool enabled);
+
 
 	/**
 	 * Imprime o Sudoku.
 	 */
 	void print();
 
+	/**
+	 * Numeros que podem ser colocados na linha x, coluna y (vazio se ja preenchida).
+	 */
 	vector<int> possibleNumbers(int x, int y);
 
+	/**
+	 * Indica se num pode ser colocado na linha x, coluna y.
+	 */
 	bool isNumberPossible(int x, int y, int num);
 };
 
@@ -0,0 +1,167 @@
+/*
+ * SudokuBatch.cpp
+ *
+ */
+
+#include "SudokuBatch.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <thread>
+#include <string.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+/* Puzzles reservados de cada vez por um trabalhador */
+const size_t CHUNK = 64;
+
+/* Ficheiro mapeado so para leitura, desmapeado no destrutor. */
+class MappedFile
+{
+	int fd;
+	const char *data;
+	size_t size;
+
+public:
+	MappedFile(const string &path) : fd(-1), data(nullptr), size(0)
+	{
+		fd = open(path.c_str(), O_RDONLY);
+		struct stat info;
+		if (fd < 0 || fstat(fd, &info) != 0)
+		{
+			if (fd >= 0)
+				close(fd);
+			throw IllegalArgumentException;
+		}
+		size = info.st_size;
+		if (size == 0)
+			return;
+		void *mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (mapped == MAP_FAILED)
+		{
+			close(fd);
+			throw IllegalArgumentException;
+		}
+		madvise(mapped, size, MADV_SEQUENTIAL);
+		data = (const char *) mapped;
+	}
+
+	~MappedFile()
+	{
+		if (data != nullptr)
+			munmap((void *) data, size);
+		close(fd);
+	}
+
+	MappedFile(const MappedFile &) = delete;
+	MappedFile &operator=(const MappedFile &) = delete;
+
+	const char *getData() const { return data; }
+	size_t getSize() const { return size; }
+};
+
+/* Inicio de cada linha com pelo menos 81 caracteres que nao seja comentario. */
+vector<const char *> findPuzzles(const char *data, size_t size)
+{
+	vector<const char *> puzzles;
+	const char *end = data + size;
+	for (const char *line = data; line < end;)
+	{
+		const char *newline = (const char *) memchr(line, '\n', end - line);
+		const char *lineEnd = newline != nullptr ? newline : end;
+		if (lineEnd - line >= 81 && line[0] != '#')
+			puzzles.push_back(line);
+		line = lineEnd + 1;
+	}
+	return puzzles;
+}
+
+double percentile(const vector<double> &sorted, double fraction)
+{
+	if (sorted.empty())
+		return 0;
+	size_t rank = (size_t) (fraction * sorted.size());
+	return sorted[min(rank, sorted.size() - 1)];
+}
+}
+
+BatchReport solveBatch(const char *data, size_t size, string &output,
+		unsigned numThreads, SudokuSolver solver)
+{
+	auto start = chrono::steady_clock::now();
+	vector<const char *> puzzles = findPuzzles(data, size);
+	size_t count = puzzles.size();
+
+	output.assign(count * 82, '\n');
+	vector<double> latencies(count);
+	vector<char> solved(count, 0);
+	atomic<size_t> next(0);
+
+	auto worker = [&]()
+	{
+		Sudoku sudoku(solver);
+		for (;;)
+		{
+			size_t first = next.fetch_add(CHUNK);
+			if (first >= count)
+				return;
+			size_t last = min(first + CHUNK, count);
+			for (size_t p = first; p < last; p++)
+			{
+				auto puzzleStart = chrono::steady_clock::now();
+				char *line = &output[p * 82];
+				if (sudoku.load(puzzles[p]) && sudoku.solve())
+				{
+					sudoku.store(line);
+					solved[p] = 1;
+				}
+				else
+					memcpy(line, puzzles[p], 81);
+				chrono::duration<double, micro> elapsed = chrono::steady_clock::now() - puzzleStart;
+				latencies[p] = elapsed.count();
+			}
+		}
+	};
+
+	if (numThreads == 0)
+		numThreads = max(1u, thread::hardware_concurrency());
+	numThreads = (unsigned) min((size_t) numThreads, max((size_t) 1, (count + CHUNK - 1) / CHUNK));
+	vector<thread> workers;
+	for (unsigned t = 1; t < numThreads; t++)
+		workers.emplace_back(worker);
+	worker();
+	for (thread &t : workers)
+		t.join();
+
+	BatchReport report;
+	report.puzzles = count;
+	report.solved = count_if(solved.begin(), solved.end(), [](char s) { return s != 0; });
+	chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+	report.seconds = elapsed.count();
+	report.puzzlesPerSecond = report.seconds > 0 ? count / report.seconds : 0;
+	sort(latencies.begin(), latencies.end());
+	report.p50Us = percentile(latencies, 0.50);
+	report.p90Us = percentile(latencies, 0.90);
+	report.p99Us = percentile(latencies, 0.99);
+	report.maxUs = latencies.empty() ? 0 : latencies.back();
+	return report;
+}
+
+BatchReport solveBatchFile(const string &inputPath, const string &outputPath,
+		unsigned numThreads, SudokuSolver solver)
+{
+	MappedFile input(inputPath);
+	string output;
+	BatchReport report = solveBatch(input.getData(), input.getSize(), output, numThreads, solver);
+
+	ofstream out(outputPath, ios::binary);
+	if (!out)
+		throw IllegalArgumentException;
+	out.write(output.data(), output.size());
+	return report;
+}
@@ -0,0 +1,45 @@
+/*
+ * SudokuBatch.h
+ *
+ */
+
+#ifndef SUDOKUBATCH_H_
+#define SUDOKUBATCH_H_
+
+#include "Sudoku.h"
+
+/**
+ * Resultado de uma resolucao em lote: quantidades, debito e percentis da
+ * latencia por puzzle (carregar + resolver), em microssegundos.
+ */
+struct BatchReport
+{
+	size_t puzzles;
+	size_t solved;
+	double seconds;
+	double puzzlesPerSecond;
+	double p50Us;
+	double p90Us;
+	double p99Us;
+	double maxUs;
+};
+
+/**
+ * Resolve em lote os puzzles de data, um por linha no formato de 81
+ * caracteres (linhas vazias, comentarios '#' e linhas curtas sao ignorados).
+ * Os puzzles sao repartidos por numThreads trabalhadores (0 = um por nucleo),
+ * cada um com o seu Sudoku, e as solucoes ficam em output pela ordem de
+ * entrada, uma por linha. Um puzzle invalido ou impossivel e copiado tal como
+ * esta e nao conta como resolvido.
+ */
+BatchReport solveBatch(const char *data, size_t size, string &output,
+		unsigned numThreads = 0, SudokuSolver solver = BACKTRACKING_SOLVER);
+
+/**
+ * Como o anterior, lendo inputPath por mmap e escrevendo em outputPath.
+ * Lanca IllegalArgumentException se os ficheiros nao puderem ser abertos.
+ */
+BatchReport solveBatchFile(const string &inputPath, const string &outputPath,
+		unsigned numThreads = 0, SudokuSolver solver = BACKTRACKING_SOLVER);
+
+#endif /* SUDOKUBATCH_H_ */
@@ -0,0 +1,102 @@
+/*
+ * SudokuGenerator.cpp
+ *
+ */
+
+#include "SudokuGenerator.h"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <numeric>
+#include <thread>
+
+SudokuGenerator::SudokuGenerator(unsigned seed) : rng(seed)
+{
+}
+
+string SudokuGenerator::randomGrid()
+{
+	board.clear();
+	int numbers[9];
+	iota(numbers, numbers + 9, 1);
+	for (int block = 0; block < 3; block++)
+	{
+		shuffle(numbers, numbers + 9, rng);
+		for (int k = 0; k < 9; k++)
+			board.set(block * 3 + k / 3, block * 3 + k % 3, numbers[k]);
+	}
+	board.solve();
+
+	string grid(81, '.');
+	board.store(&grid[0]);
+	return grid;
+}
+
+GeneratedPuzzle SudokuGenerator::generate()
+{
+	GeneratedPuzzle result;
+	result.solution = randomGrid();
+	string puzzle = result.solution;
+
+	int order[81];
+	iota(order, order + 81, 0);
+	shuffle(order, order + 81, rng);
+	for (int cell : order)
+	{
+		char clue = puzzle[cell];
+		puzzle[cell] = '.';
+		board.load(puzzle.c_str());
+		if (board.countSolutions(2) != 1)
+			puzzle[cell] = clue;
+	}
+
+	result.puzzle = puzzle;
+	result.clues = count_if(puzzle.begin(), puzzle.end(), [](char c) { return c != '.'; });
+	result.difficulty = rate(puzzle, &result.stats);
+	return result;
+}
+
+long SudokuGenerator::rate(const string &puzzle, SolverStats *stats)
+{
+	SolverStats counted;
+	board.load(puzzle.c_str());
+	board.solve(counted);
+	if (stats != nullptr)
+		*stats = counted;
+	return counted.nodes;
+}
+
+vector<GeneratedPuzzle> generatePuzzles(size_t count, long minDifficulty, long maxDifficulty,
+		unsigned numThreads, unsigned seed, size_t maxAttempts)
+{
+	vector<GeneratedPuzzle> puzzles;
+	mutex puzzlesMutex;
+	atomic<size_t> accepted(0), attempts(0);
+
+	auto worker = [&](unsigned self)
+	{
+		SudokuGenerator generator(seed + 7919 * self);
+		while (accepted.load() < count && attempts.fetch_add(1) < maxAttempts)
+		{
+			GeneratedPuzzle puzzle = generator.generate();
+			if (puzzle.difficulty < minDifficulty || puzzle.difficulty > maxDifficulty)
+				continue;
+			lock_guard<mutex> lock(puzzlesMutex);
+			if (puzzles.size() < count)
+			{
+				puzzles.push_back(move(puzzle));
+				accepted = puzzles.size();
+			}
+		}
+	};
+
+	if (numThreads == 0)
+		numThreads = max(1u, thread::hardware_concurrency());
+	vector<thread> workers;
+	for (unsigned t = 1; t < numThreads; t++)
+		workers.emplace_back(worker, t);
+	worker(0);
+	for (thread &t : workers)
+		t.join();
+	return puzzles;
+}
@@ -0,0 +1,73 @@
+/*
+ * SudokuGenerator.h
+ *
+ */
+
+#ifndef SUDOKUGENERATOR_H_
+#define SUDOKUGENERATOR_H_
+
+#include "Sudoku.h"
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * Puzzle gerado, no formato de 81 caracteres, com a sua solucao unica.
+ * stats sao as estatisticas do Sudoku ao resolve-lo e difficulty o numero
+ * de nos da pesquisa (1 = resolvido so por propagacao).
+ */
+struct GeneratedPuzzle
+{
+	string puzzle;
+	string solution;
+	int clues;
+	long difficulty;
+	SolverStats stats;
+};
+
+/**
+ * Gerador de puzzles 9x9 com solucao unica. Cada instancia tem o seu
+ * gerador aleatorio e o seu tabuleiro, por isso deve ser usada por uma so
+ * thread; varias instancias podem correr em paralelo.
+ */
+class SudokuGenerator
+{
+	mt19937 rng;
+	GenericSudoku<3> board;
+
+public:
+	SudokuGenerator(unsigned seed);
+
+	/**
+	 * Grelha completa aleatoria: os tres blocos da diagonal (independentes
+	 * entre si) sao permutacoes aleatorias e o resto e completado pelo solver.
+	 */
+	string randomGrid();
+
+	/**
+	 * Parte de uma grelha aleatoria e tenta apagar cada celula, por ordem
+	 * aleatoria, mantendo o apagamento so se a solucao continuar unica.
+	 * O resultado e minimo: nenhuma pista pode ser retirada.
+	 */
+	GeneratedPuzzle generate();
+
+	/**
+	 * Dificuldade de um puzzle: nos da pesquisa ao resolve-lo, com o mesmo
+	 * motor usado para verificar a unicidade.
+	 * Se stats nao for nulo recebe as restantes estatisticas.
+	 */
+	long rate(const string &puzzle, SolverStats *stats = nullptr);
+};
+
+/**
+ * Gera count puzzles com dificuldade entre minDifficulty e maxDifficulty,
+ * com numThreads geradores independentes (0 = um por nucleo), cada um com
+ * a sua semente derivada de seed. Desiste ao fim de maxAttempts puzzles
+ * gerados no total, pelo que pode devolver menos de count.
+ */
+vector<GeneratedPuzzle> generatePuzzles(size_t count, long minDifficulty = 0, long maxDifficulty = 1L << 30,
+		unsigned numThreads = 0, unsigned seed = 2019, size_t maxAttempts = 100000);
+
+#endif /* SUDOKUGENERATOR_H_ */
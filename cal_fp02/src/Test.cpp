@@ -4,6 +4,10 @@
 #include "cute/cute_runner.h"
 #include "Sudoku.h"
 #include "Labirinth.h"
+#include "SudokuBatch.h"
+#include "GenericSudoku.h"
+#include "SudokuGenerator.h"
+#include <fstream>
 
 void compareSudokus(int in[9][9], int out[9][9])
 {
@@ -256,6 +260,496 @@ void testSudokuImpossible()
 	compareSudokus(in, out);
 }
 
+void testSudokuDancingLinks()
+{
+	int in[9][9] =
+		   {{7, 0, 0, 1, 0, 8, 0, 0, 0},
+			{0, 9, 0, 0, 0, 0, 0, 3, 2},
+			{0, 0, 0, 0, 0, 5, 0, 0, 0},
+			{0, 0, 0, 0, 0, 0, 1, 0, 0},
+			{9, 6, 0, 0, 2, 0, 0, 0, 0},
+			{0, 0, 0, 0, 0, 0, 8, 0, 0},
+			{0, 0, 0, 0, 0, 0, 0, 0, 0},
+			{0, 0, 5, 0, 0, 1, 0, 0, 0},
+			{3, 2, 0, 0, 0, 0, 0, 0, 6}};
+
+	int out[9][9] =
+		   {{7, 5, 2, 1, 3, 8, 6, 9, 4},
+			{1, 9, 8, 7, 4, 6, 5, 3, 2},
+			{4, 3, 6, 2, 9, 5, 7, 8, 1},
+			{2, 8, 3, 4, 5, 9, 1, 6, 7},
+			{9, 6, 1, 8, 2, 7, 3, 4, 5},
+			{5, 7, 4, 6, 1, 3, 8, 2, 9},
+			{6, 1, 9, 3, 7, 2, 4, 5, 8},
+			{8, 4, 5, 9, 6, 1, 2, 7, 3},
+			{3, 2, 7, 5, 8, 4, 9, 1, 6}};
+
+	Sudoku s(in, DLX_SOLVER);
+	ASSERT_EQUAL(s.solve(), true);
+	ASSERT_EQUAL(s.isComplete(), true);
+
+	int sout[9][9];
+	int** res = s.getNumbers();
+
+	for (int i = 0; i < 9; i++)
+		for (int a = 0; a < 9; a++)
+			sout[i][a] = res[i][a];
+
+	compareSudokus(out, sout);
+
+	// Backend chosen per call; an impossible grid is left untouched.
+	in[1][0] = 4;
+	Sudoku impossible(in);
+	ASSERT_EQUAL(impossible.solve(DLX_SOLVER), false);
+	res = impossible.getNumbers();
+	for (int i = 0; i < 9; i++)
+		for (int a = 0; a < 9; a++)
+			ASSERT_EQUAL(in[i][a], res[i][a]);
+
+	Sudoku empty(DLX_SOLVER);
+	ASSERT_EQUAL(empty.solve(), true);
+	ASSERT_EQUAL(empty.isComplete(), true);
+
+	// The exact-cover matrix is built once per instance and restored after
+	// every solve, even a failed one.
+	string minimal = "7..1.8....9.....32.....5.........1..96..2..........8.............5..1...32......6";
+	string solution = "752138694198746532436295781283459167961827345574613829619372458845961273327584916";
+	string unsolvable = minimal;
+	unsolvable[9] = '4';
+	char stored[82] = {};
+	Sudoku reused(DLX_SOLVER);
+	for (int round = 0; round < 3; round++)
+	{
+		ASSERT_EQUAL(true, reused.load(unsolvable.c_str()));
+		ASSERT_EQUAL(false, reused.solve());
+		ASSERT_EQUAL(true, reused.load(minimal.c_str()));
+		ASSERT_EQUAL(true, reused.solve());
+		reused.store(stored);
+		ASSERT_EQUAL(solution, string(stored));
+	}
+}
+
+void testSudokuPropagation()
+{
+	int in[9][9] =
+		 {{8, 6, 0, 0, 0, 0, 0, 9, 0},
+		  {0, 0, 4, 0, 7, 6, 3, 0, 0},
+		  {9, 0, 0, 0, 2, 5, 1, 0, 0},
+		  {0, 7, 6, 1, 3, 0, 0, 2, 0},
+		  {2, 1, 0, 0, 0, 0, 0, 3, 7},
+		  {0, 4, 0, 0, 6, 2, 8, 5, 0},
+		  {0, 0, 3, 4, 8, 0, 0, 0, 9},
+		  {0, 0, 5, 2, 1, 0, 4, 0, 0},
+		  {0, 9, 0, 0, 0, 0, 0, 7, 8}};
+
+	int empty = 0;
+	for (int i = 0; i < 9; i++)
+		for (int a = 0; a < 9; a++)
+			empty += in[i][a] == 0;
+
+	// Solved by propagation alone: every empty cell is a naked or hidden single.
+	Sudoku s(in);
+	SolverStats stats;
+	ASSERT_EQUAL(s.solve(stats), true);
+	ASSERT_EQUAL(empty, stats.nakedSingles + stats.hiddenSingles);
+	ASSERT_EQUAL(1, stats.nodes);
+
+	Sudoku plain(in);
+	plain.setPropagationEnabled(false);
+	SolverStats plainStats;
+	ASSERT_EQUAL(plain.solve(plainStats), true);
+	ASSERT_EQUAL(0, plainStats.nakedSingles);
+
+	int** res = s.getNumbers();
+	int** plainRes = plain.getNumbers();
+	for (int i = 0; i < 9; i++)
+		for (int a = 0; a < 9; a++)
+			ASSERT_EQUAL(res[i][a], plainRes[i][a]);
+
+	int hard[9][9] =
+		   {{1, 0, 0, 0, 0, 7, 0, 9, 0},
+			{0, 3, 0, 0, 2, 0, 0, 0, 8},
+			{0, 0, 9, 6, 0, 0, 5, 0, 0},
+			{0, 0, 5, 3, 0, 0, 9, 0, 0},
+			{0, 1, 0, 0, 8, 0, 0, 0, 2},
+			{6, 0, 0, 0, 0, 4, 0, 0, 0},
+			{3, 0, 0, 0, 0, 0, 0, 1, 0},
+			{0, 4, 0, 0, 0, 0, 0, 0, 7},
+			{0, 0, 7, 0, 0, 0, 3, 0, 0}};
+	Sudoku escargot(hard);
+	SolverStats hardStats;
+	ASSERT_EQUAL(escargot.solve(hardStats), true);
+	ASSERT_EQUAL(true, hardStats.lockedCandidates > 0);
+}
+
+void testSudokuBatch()
+{
+	string minimal = "7..1.8....9.....32.....5.........1..96..2..........8.............5..1...32......6";
+	string solution = "752138694198746532436295781283459167961827345574613829619372458845961273327584916";
+	string impossible = minimal;
+	impossible[9] = '4';
+	string invalid = minimal;
+	invalid[1] = '7';
+
+	string input = "# comentario\n" + minimal + "\n\n" + impossible + "\r\n" + invalid + "\n";
+	for (int k = 0; k < 200; k++)
+		input += minimal + "\n";
+
+	string output;
+	BatchReport report = solveBatch(input.data(), input.size(), output, 3);
+	ASSERT_EQUAL(203u, report.puzzles);
+	ASSERT_EQUAL(201u, report.solved);
+	ASSERT_EQUAL(203u * 82, output.size());
+	ASSERT_EQUAL(solution, output.substr(0, 81));
+	ASSERT_EQUAL(impossible, output.substr(82, 81));
+	ASSERT_EQUAL(invalid, output.substr(2 * 82, 81));
+	ASSERT_EQUAL(solution, output.substr(202 * 82, 81));
+	ASSERT_EQUAL(true, report.p50Us <= report.p99Us && report.p99Us <= report.maxUs);
+
+	string inputPath = "batch_test_in.txt", outputPath = "batch_test_out.txt";
+	ofstream(inputPath) << minimal << "\n" << impossible << "\n";
+	report = solveBatchFile(inputPath, outputPath, 2, DLX_SOLVER);
+	ASSERT_EQUAL(2u, report.puzzles);
+	ASSERT_EQUAL(1u, report.solved);
+	ifstream result(outputPath);
+	string line;
+	getline(result, line);
+	ASSERT_EQUAL(solution, line);
+	getline(result, line);
+	ASSERT_EQUAL(impossible, line);
+	remove(inputPath.c_str());
+	remove(outputPath.c_str());
+	ASSERT_THROWS(solveBatchFile(inputPath, outputPath), int);
+
+	Sudoku s;
+	ASSERT_EQUAL(false, s.load(invalid.c_str()));
+	ASSERT_EQUAL(true, s.load(minimal.c_str()));
+	char stored[82] = {};
+	s.store(stored);
+	ASSERT_EQUAL(minimal, string(stored));
+}
+
+template <int BoxSize>
+void checkGenericSolution(const GenericSudoku<BoxSize> &s, const string &puzzle)
+{
+	const int N = BoxSize * BoxSize;
+	ASSERT_EQUAL(true, s.isComplete());
+	for (int u = 0; u < N; u++)
+	{
+		uint64_t line = 0, column = 0, block = 0;
+		for (int k = 0; k < N; k++)
+		{
+			line |= 1ull << s.get(u, k);
+			column |= 1ull << s.get(k, u);
+			block |= 1ull << s.get(u / BoxSize * BoxSize + k / BoxSize, u % BoxSize * BoxSize + k % BoxSize);
+		}
+		uint64_t all = ((1ull << N) - 1) << 1;
+		ASSERT_EQUAL(all, line);
+		ASSERT_EQUAL(all, column);
+		ASSERT_EQUAL(all, block);
+	}
+	vector<char> stored(N * N);
+	s.store(stored.data());
+	for (int cell = 0; cell < N * N; cell++)
+		if (puzzle[cell] != '.')
+			ASSERT_EQUAL(puzzle[cell], stored[cell]);
+}
+
+/* Grelha-padrao valida com as celulas (i + 2j) % 5 != 0 apagadas */
+template <int BoxSize>
+string genericPuzzle()
+{
+	const int N = BoxSize * BoxSize;
+	string puzzle(N * N, '.');
+	for (int i = 0; i < N; i++)
+	{
+		for (int j = 0; j < N; j++)
+		{
+			int n = (BoxSize * (i % BoxSize) + i / BoxSize + j) % N + 1;
+			if ((i + 2 * j) % 5 == 0)
+				puzzle[i * N + j] = n <= 9 ? '0' + n : 'A' + n - 10;
+		}
+	}
+	return puzzle;
+}
+
+void testGenericSudoku()
+{
+	ASSERT_EQUAL(2u, sizeof(GenericSudoku<3>::Mask));
+	ASSERT_EQUAL(2u, sizeof(GenericSudoku<4>::Mask));
+	ASSERT_EQUAL(4u, sizeof(GenericSudoku<5>::Mask));
+	ASSERT_EQUAL(8u, sizeof(GenericSudoku<8>::Mask));
+
+	string minimal = "7..1.8....9.....32.....5.........1..96..2..........8.............5..1...32......6";
+	GenericSudoku<3> nine;
+	ASSERT_EQUAL(true, nine.load(minimal.c_str()));
+	ASSERT_EQUAL(true, nine.solve());
+	char solution[82] = {};
+	nine.store(solution);
+	ASSERT_EQUAL("752138694198746532436295781283459167961827345574613829619372458845961273327584916", string(solution));
+
+	string impossible = minimal;
+	impossible[9] = '4';
+	ASSERT_EQUAL(true, nine.load(impossible.c_str()));
+	ASSERT_EQUAL(false, nine.solve());
+	char unchanged[82] = {};
+	nine.store(unchanged);
+	ASSERT_EQUAL(impossible, string(unchanged));
+	ASSERT_EQUAL(false, nine.set(0, 1, 7));
+
+	string sixteen = genericPuzzle<4>();
+	GenericSudoku<4> s16;
+	ASSERT_EQUAL(true, s16.load(sixteen.c_str()));
+	ASSERT_EQUAL(true, s16.solve());
+	checkGenericSolution(s16, sixteen);
+
+	string twentyFive = genericPuzzle<5>();
+	GenericSudoku<5> s25;
+	ASSERT_EQUAL(true, s25.load(twentyFive.c_str()));
+	ASSERT_EQUAL(true, s25.solve());
+	checkGenericSolution(s25, twentyFive);
+}
+
+void testParallelSolve()
+{
+	string sixteen = genericPuzzle<4>();
+	GenericSudoku<4> s16;
+	ASSERT_EQUAL(true, s16.load(sixteen.c_str()));
+	ParallelStats stats;
+	ASSERT_EQUAL(true, s16.solveParallel(4, &stats));
+	checkGenericSolution(s16, sixteen);
+	ASSERT_EQUAL(4u, stats.nodesPerThread.size());
+
+	string minimal = "7..1.8....9.....32.....5.........1..96..2..........8.............5..1...32......6";
+	Sudoku s;
+	ASSERT_EQUAL(true, s.load(minimal.c_str()));
+	ASSERT_EQUAL(true, s.solveParallel(3, &stats));
+	char solution[82] = {};
+	s.store(solution);
+	ASSERT_EQUAL("752138694198746532436295781283459167961827345574613829619372458845961273327584916", string(solution));
+	ASSERT_EQUAL(true, stats.tasks >= 1);
+	long nodes = 0;
+	int tasks = 0, splits = 0;
+	for (unsigned t = 0; t < 3; t++)
+	{
+		nodes += stats.nodesPerThread[t];
+		tasks += stats.tasksPerThread[t];
+		splits += stats.splitsPerThread[t];
+	}
+	ASSERT_EQUAL(true, nodes >= tasks && tasks <= stats.tasks + splits);
+
+	// Sem solucao: todas as tarefas esgotam-se e o tabuleiro fica como estava.
+	string impossible = minimal;
+	impossible[9] = '4';
+	Sudoku none;
+	ASSERT_EQUAL(true, none.load(impossible.c_str()));
+	ASSERT_EQUAL(false, none.solveParallel(4, &stats));
+	none.store(solution);
+	ASSERT_EQUAL(impossible, string(solution));
+
+	// Sem solucao e sem propagacao a arvore e grande: as threads que ficam sem
+	// tarefas roubam-nas ou recebem ramos cedidos, todas as tarefas sao
+	// executadas e os nos somados sao os mesmos da pesquisa sequencial.
+	string unsolvable = "8......9...36......7..9.2...5...7.......457.....1...3...1....68..85...1..9....4..";
+	GenericSudoku<3> sequential;
+	sequential.load(unsolvable.c_str());
+	sequential.setPropagationEnabled(false);
+	ASSERT_EQUAL(false, sequential.solve());
+	long sequentialNodes = sequential.getNodes();
+	int shared = 0;
+	for (int run = 0; run < 20 && shared == 0; run++)
+	{
+		GenericSudoku<3> many;
+		many.load(unsolvable.c_str());
+		many.setPropagationEnabled(false);
+		ASSERT_EQUAL(false, many.solveParallel(4, &stats));
+		ASSERT_EQUAL(sequentialNodes, many.getNodes());
+		int manyTasks = 0, manySplits = 0;
+		for (unsigned t = 0; t < 4; t++)
+		{
+			manyTasks += stats.tasksPerThread[t];
+			manySplits += stats.splitsPerThread[t];
+			shared += stats.stealsPerThread[t] + stats.splitsPerThread[t];
+		}
+		ASSERT_EQUAL(stats.tasks + manySplits, manyTasks);
+	}
+	ASSERT_EQUAL(true, shared > 0);
+
+	// Mesmas regras que a pesquisa sequencial (incluindo candidatos bloqueados):
+	// com uma thread a arvore explorada e a mesma.
+	string hard = "8..........36......7..9.2...5...7.......457.....1...3...1....68..85...1..9....4..";
+	Sudoku serial;
+	serial.load(hard.c_str());
+	SolverStats serialStats;
+	ASSERT_EQUAL(true, serial.solve(BACKTRACKING_SOLVER, serialStats));
+	GenericSudoku<3> generic;
+	generic.load(hard.c_str());
+	ASSERT_EQUAL(true, generic.solve());
+	ASSERT_EQUAL(serialStats.nodes, generic.getNodes());
+
+	// setPropagationEnabled(false) tambem se aplica a pesquisa paralela.
+	Sudoku propagated, plain;
+	propagated.load(hard.c_str());
+	plain.load(hard.c_str());
+	plain.setPropagationEnabled(false);
+	ParallelStats propagatedStats, plainStats;
+	ASSERT_EQUAL(true, propagated.solveParallel(1, &propagatedStats));
+	ASSERT_EQUAL(true, plain.solveParallel(1, &plainStats));
+	ASSERT_EQUAL(true, plainStats.nodesPerThread[0] > 10 * propagatedStats.nodesPerThread[0]);
+	propagated.store(solution);
+	char plainSolution[82] = {};
+	plain.store(plainSolution);
+	ASSERT_EQUAL(string(solution), string(plainSolution));
+}
+
+void testCountSolutions()
+{
+	string minimal = "7..1.8....9.....32.....5.........1..96..2..........8.............5..1...32......6";
+	string multiple = minimal;
+	multiple[0] = '.';
+	string impossible = minimal;
+	impossible[9] = '4';
+
+	Sudoku s;
+	ASSERT_EQUAL(true, s.load(minimal.c_str()));
+	ASSERT_EQUAL(1, s.countSolutions());
+	ASSERT_EQUAL(1, s.countSolutions(10));
+	ASSERT_EQUAL(0, s.countSolutions(0));
+	char stored[82] = {};
+	s.store(stored);
+	ASSERT_EQUAL(minimal, string(stored));
+
+	ASSERT_EQUAL(true, s.load(multiple.c_str()));
+	ASSERT_EQUAL(2, s.countSolutions());
+	ASSERT_EQUAL(true, s.countSolutions(1000) > 2);
+	s.setPropagationEnabled(false);
+	ASSERT_EQUAL(5, s.countSolutions(5));
+	s.setPropagationEnabled(true);
+
+	ASSERT_EQUAL(true, s.load(impossible.c_str()));
+	ASSERT_EQUAL(0, s.countSolutions());
+
+	// Grelha 4x4 vazia: 288 solucoes.
+	GenericSudoku<2> four;
+	ASSERT_EQUAL(288, four.countSolutions(1000));
+	ASSERT_EQUAL(100, four.countSolutions(100));
+	ASSERT_EQUAL(false, four.isComplete());
+
+	GenericSudoku<3> nine;
+	ASSERT_EQUAL(true, nine.load(minimal.c_str()));
+	ASSERT_EQUAL(1, nine.countSolutions());
+	ASSERT_EQUAL(true, nine.load(multiple.c_str()));
+	ASSERT_EQUAL(2, nine.countSolutions());
+	nine.store(stored);
+	ASSERT_EQUAL(multiple, string(stored));
+}
+
+void testSudokuGenerator()
+{
+	SudokuGenerator generator(7);
+	string grid = generator.randomGrid();
+	Sudoku full;
+	ASSERT_EQUAL(true, full.load(grid.c_str()));
+	ASSERT_EQUAL(true, full.isComplete());
+
+	GeneratedPuzzle generated = generator.generate();
+	Sudoku s;
+	ASSERT_EQUAL(true, s.load(generated.puzzle.c_str()));
+	ASSERT_EQUAL(1, s.countSolutions());
+	ASSERT_EQUAL(true, s.solve(DLX_SOLVER));
+	char solution[82] = {};
+	s.store(solution);
+	ASSERT_EQUAL(generated.solution, string(solution));
+	ASSERT_EQUAL(true, generated.clues >= 17 && generated.difficulty >= 1);
+
+	// Minimo: tirar qualquer pista deixa de dar solucao unica.
+	for (int cell = 0; cell < 81; cell++)
+	{
+		if (generated.puzzle[cell] == '.')
+			continue;
+		string fewer = generated.puzzle;
+		fewer[cell] = '.';
+		ASSERT_EQUAL(true, s.load(fewer.c_str()));
+		ASSERT_EQUAL(2, s.countSolutions());
+	}
+
+	vector<GeneratedPuzzle> batch = generatePuzzles(6, 2, 1L << 30, 3);
+	ASSERT_EQUAL(6u, batch.size());
+	for (const GeneratedPuzzle &puzzle : batch)
+	{
+		ASSERT_EQUAL(true, puzzle.difficulty >= 2);
+		ASSERT_EQUAL(true, s.load(puzzle.puzzle.c_str()));
+		ASSERT_EQUAL(1, s.countSolutions());
+	}
+
+	// Intervalo impossivel: desiste ao fim de maxAttempts.
+	ASSERT_EQUAL(0u, generatePuzzles(1, 2, 1, 2, 1, 4).size());
+}
+
+void testSolverStats()
+{
+	string escargot = "1....7.9..3..2...8..96..5....53..9...1..8...26....4...3......1..4......7..7...3..";
+	Sudoku counted, plain;
+	ASSERT_EQUAL(true, counted.load(escargot.c_str()));
+	ASSERT_EQUAL(true, plain.load(escargot.c_str()));
+
+	SolverStats stats;
+	NoStats none;
+	ASSERT_EQUAL(true, counted.solve(stats));
+	ASSERT_EQUAL(true, plain.solve(none));
+	int** a = counted.getNumbers();
+	int** b = plain.getNumbers();
+	for (int i = 0; i < 9; i++)
+		for (int j = 0; j < 9; j++)
+			ASSERT_EQUAL(a[i][j], b[i][j]);
+
+	// Cada no alem da raiz e uma tentativa feita numa ramificacao.
+	long branches = 0;
+	for (int k = 0; k < 10; k++)
+		branches += stats.branchingCandidates[k];
+	ASSERT_EQUAL(true, branches > 0 && branches < stats.nodes);
+	ASSERT_EQUAL(0, stats.branchingCandidates[0] + stats.branchingCandidates[1]);
+	ASSERT_EQUAL(true, stats.backtracks > 0 && stats.backtracks < stats.nodes);
+	ASSERT_EQUAL(true, stats.nakedSingles + stats.hiddenSingles > 0);
+
+	// A DLX nao e instrumentada.
+	SolverStats dlxStats;
+	ASSERT_EQUAL(true, plain.load(escargot.c_str()));
+	ASSERT_EQUAL(true, plain.solve(DLX_SOLVER, dlxStats));
+	ASSERT_EQUAL(0, dlxStats.nodes);
+
+	SudokuGenerator generator(11);
+	SolverStats rated;
+	ASSERT_EQUAL(stats.nodes, generator.rate(escargot, &rated));
+	ASSERT_EQUAL(stats.backtracks, rated.backtracks);
+}
+
+void testSudokuCandidates()
+{
+	int in[9][9] =
+		 {{8, 6, 0, 0, 0, 0, 0, 9, 0},
+		  {0, 0, 4, 0, 7, 6, 3, 0, 0},
+		  {9, 0, 0, 0, 2, 5, 1, 0, 0},
+		  {0, 7, 6, 1, 3, 0, 0, 2, 0},
+		  {2, 1, 0, 0, 0, 0, 0, 3, 7},
+		  {0, 4, 0, 0, 6, 2, 8, 5, 0},
+		  {0, 0, 3, 4, 8, 0, 0, 0, 9},
+		  {0, 0, 5, 2, 1, 0, 4, 0, 0},
+		  {0, 9, 0, 0, 0, 0, 0, 7, 8}};
+
+	Sudoku s(in);
+	vector<int> expected = {1, 2, 7};
+	ASSERT_EQUAL(expected, s.possibleNumbers(0, 2));
+	ASSERT_EQUAL(true, s.possibleNumbers(0, 0).empty());
+	ASSERT_EQUAL(true, s.isNumberPossible(0, 2, 2));
+	ASSERT_EQUAL(false, s.isNumberPossible(0, 2, 8));
+	ASSERT_EQUAL(false, s.isNumberPossible(0, 0, 8));
+
+	in[0][2] = 6;
+	ASSERT_THROWS(Sudoku bad(in), int);
+	in[0][2] = 10;
+	ASSERT_THROWS(Sudoku bad(in), int);
+}
 
 void testLabirinth()
 {
@@ -304,6 +798,15 @@ bool runAllTests(int argc, char const *argv[]) {
 	s.push_back(CUTE(testSudokuWithMultipleSolutions));
 	s.push_back(CUTE(testSudokuEmpty));
 	s.push_back(CUTE(testSudokuImpossible));
+	s.push_back(CUTE(testSudokuDancingLinks));
+	s.push_back(CUTE(testSudokuPropagation));
+	s.push_back(CUTE(testSudokuBatch));
+	s.push_back(CUTE(testGenericSudoku));
+	s.push_back(CUTE(testParallelSolve));
+	s.push_back(CUTE(testCountSolutions));
+	s.push_back(CUTE(testSudokuGenerator));
+	s.push_back(CUTE(testSolverStats));
+	s.push_back(CUTE(testSudokuCandidates));
 	s.push_back(CUTE(testLabirinth));
 	cute::xml_file_opener xmlfile(argc, argv);
 	cute::xml_listener<cute::ide_listener<>> lis(xmlfile.out);
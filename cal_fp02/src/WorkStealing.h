@@ -0,0 +1,55 @@
+/*
+ * WorkStealing.h
+ *
+ */
+
+#ifndef WORKSTEALING_H_
+#define WORKSTEALING_H_
+
+#include <deque>
+#include <mutex>
+
+using namespace std;
+
+/**
+ * Fila de tarefas de um trabalhador. O dono tira do fim (as tarefas mais
+ * recentes, ainda quentes na cache); os outros roubam do inicio, onde estao
+ * as tarefas mais antigas e, numa pesquisa em arvore, as maiores.
+ */
+template <class T>
+class WorkStealingDeque
+{
+	deque<T> tasks;
+	mutex dequeMutex;
+
+public:
+	void push(T task)
+	{
+		lock_guard<mutex> lock(dequeMutex);
+		tasks.push_back(move(task));
+	}
+
+	/* Tarefa do dono; false se a fila estiver vazia */
+	bool pop(T &task)
+	{
+		lock_guard<mutex> lock(dequeMutex);
+		if (tasks.empty())
+			return false;
+		task = move(tasks.back());
+		tasks.pop_back();
+		return true;
+	}
+
+	/* Tarefa roubada por outro trabalhador; false se a fila estiver vazia */
+	bool steal(T &task)
+	{
+		lock_guard<mutex> lock(dequeMutex);
+		if (tasks.empty())
+			return false;
+		task = move(tasks.front());
+		tasks.pop_front();
+		return true;
+	}
+};
+
+#endif /* WORKSTEALING_H_ */